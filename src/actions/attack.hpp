@@ -25,6 +25,7 @@
 #include "attack_prediction.hpp"
 #include "units/ptr.hpp"
 #include "units/unit_alignments.hpp"
+#include "utils/math.hpp"
 
 #include <vector>
 
@@ -106,9 +107,9 @@ struct battle_context_unit_stats
 		return swarm_blows(swarm_min, swarm_max, new_hp, max_hp);
 	}
 
-#if defined(BENCHMARK) || defined(CHECK)
 	/**
-	 * Special constructor for the stand-alone version of attack_prediction.cpp.
+	 * Special constructor for the stand-alone version of attack_prediction.cpp
+	 * and the combat benchmarks.
 	 * (This hardcodes some standard abilities for testing purposes.)
 	 */
 	battle_context_unit_stats(int dmg,
@@ -159,7 +160,6 @@ struct battle_context_unit_stats
 			hp = max_hp; // Keeps the prob_matrix from going out of bounds.
 		}
 	}
-#endif
 };
 
 /** Computes the statistics of a battle between an attacker and a defender unit. */
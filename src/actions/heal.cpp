@@ -33,6 +33,7 @@
 #include "utils/general.hpp"
 
 #include <list>
+#include <unordered_set>
 #include <vector>
 
 static lg::log_domain log_engine("engine");
@@ -57,6 +58,65 @@ namespace {
 		bool cure_poison;
 	};
 
+	/**
+	 * The hexes where a unit can be affected by the abilities of one type
+	 * ([heals] or [regenerate]): those of the units having such an ability,
+	 * and the hexes adjacent to them.
+	 *
+	 * This is built once per healing phase by scattering every unit with the
+	 * ability onto its neighborhood, so that the units that cannot receive the
+	 * ability (usually nearly all of them) are resolved with one lookup instead
+	 * of a scan of their neighbors. Whether the ability actually applies still
+	 * depends on its filters, which are checked by unit::get_abilities() as
+	 * before, so the results are unchanged.
+	 */
+	class ability_coverage
+	{
+	public:
+		ability_coverage(const unit_map& units, const std::string& tag_name)
+			: tag_name_(tag_name)
+			, hexes_()
+		{
+			for(const unit& u : units) {
+				if(!u.has_ability_type(tag_name)) {
+					continue;
+				}
+
+				// The unit itself, for abilities that affect_self.
+				hexes_.insert(u.get_location());
+				for(const map_location& adj : get_adjacent_tiles(u.get_location())) {
+					hexes_.insert(adj);
+				}
+			}
+		}
+
+		/** The abilities of this type affecting @a patient, as from unit::get_abilities(). */
+		unit_ability_list get_abilities(const unit& patient) const
+		{
+			if(hexes_.count(patient.get_location()) == 0) {
+				return unit_ability_list(patient.get_location());
+			}
+
+			return patient.get_abilities(tag_name_);
+		}
+
+	private:
+		std::string tag_name_;
+		std::unordered_set<map_location> hexes_;
+	};
+
+	/** Where the healing abilities can be received this turn. */
+	struct healer_coverage
+	{
+		explicit healer_coverage(const unit_map& units)
+			: heals(units, "heals")
+			, regenerate(units, "regenerate")
+		{}
+
+		ability_coverage heals;
+		ability_coverage regenerate;
+	};
+
 	// Keep these ordered from weakest cure to strongest cure.
 	enum POISON_STATUS { POISON_NORMAL, POISON_SLOW , POISON_CURE };
 
@@ -82,6 +142,7 @@ namespace {
 	 * If cured by a unit, that unit is added to @a healers.
 	 */
 	POISON_STATUS poison_progress(int side, const unit & patient,
+	                              const healer_coverage & coverage,
 	                              std::vector<unit *> & healers)
 	{
 		const std::vector<team> &teams = resources::gameboard->teams();
@@ -97,7 +158,7 @@ namespace {
 				return POISON_CURE;
 
 			// Regeneration?
-			for (const unit_ability & regen : patient.get_abilities("regenerate"))
+			for (const unit_ability & regen : coverage.regenerate.get_abilities(patient))
 			{
 				curing = std::max(curing, poison_status((*regen.ability_cfg)["poison"]));
 				if ( curing == POISON_CURE )
@@ -109,7 +170,7 @@ namespace {
 		// Look through the healers to find a curer.
 		unit_map::iterator curer = units.end();
 		// Assumed: curing is not POISON_CURE at the start of any iteration.
-		for (const unit_ability & heal : patient.get_abilities("heals"))
+		for (const unit_ability & heal : coverage.heals.get_abilities(patient))
 		{
 			POISON_STATUS this_cure = poison_status((*heal.ability_cfg)["poison"]);
 			if ( this_cure <= curing )
@@ -178,7 +239,8 @@ namespace {
 	 * Calculate how much @patient heals this turn.
 	 * If healed by units, those units are added to @a healers.
 	 */
-	int heal_amount(int side, const unit & patient, std::vector<unit *> & healers)
+	int heal_amount(int side, const unit & patient, const healer_coverage & coverage,
+	                std::vector<unit *> & healers)
 	{
 		unit_map &units = resources::gameboard->units();
 
@@ -193,13 +255,13 @@ namespace {
 			               resources::gameboard->map().gives_healing(patient.get_location()));
 
 			// Regeneration?
-			unit_ability_list regen_list = patient.get_abilities("regenerate");
+			unit_ability_list regen_list = coverage.regenerate.get_abilities(patient);
 			unit_abilities::effect regen_effect(regen_list, 0);
 			update_healing(healing, harming, regen_effect.get_composite_value());
 		}
 
 		// Check healing from other units.
-		unit_ability_list heal_list = patient.get_abilities("heals");
+		unit_ability_list heal_list = coverage.heals.get_abilities(patient);
 		// Remove all healers not on this side (since they do not heal now).
 		utils::erase_if(heal_list, [&](const unit_ability& i) {
 			unit_map::iterator healer = units.find(i.teacher_loc);
@@ -293,6 +355,10 @@ void calculate_healing(int side, bool update_display)
 
 	std::list<heal_unit> unit_list;
 
+	// Healing changes hitpoints and poison only, never where the healers
+	// are, so the coverage stays valid for the whole loop.
+	const healer_coverage coverage(resources::gameboard->units());
+
 	// We look for all allied units, then we see if our healer is near them.
 	for (unit &patient : resources::gameboard->units()) {
 
@@ -315,10 +381,10 @@ void calculate_healing(int side, bool update_display)
 
 		// Main healing.
 		if ( !patient.get_state(unit::STATE_POISONED) ) {
-			healing += heal_amount(side, patient, healers);
+			healing += heal_amount(side, patient, coverage, healers);
 		}
 		else {
-			curing = poison_progress(side, patient, healers);
+			curing = poison_progress(side, patient, coverage, healers);
 			// Poison can be cured at any time, but damage is only
 			// taken on the patient's turn.
 			if ( curing == POISON_NORMAL  &&  patient.side() == side )
@@ -164,6 +164,11 @@ game_events::pump_result_t get_village(const map_location& loc, int side, bool *
 		}
 	}
 
+	// The village counts, upkeep and income on the sidebar.
+	if (display::get_singleton() != nullptr) {
+		display::get_singleton()->invalidate_game_status();
+	}
+
 	if (!t) {
 		return game_events::pump_result_t();
 	}
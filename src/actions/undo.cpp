@@ -45,6 +45,7 @@
 
 #include <algorithm>                    // for reverse
 #include <cassert>                      // for assert
+#include <set>
 
 static lg::log_domain log_engine("engine");
 #define ERR_NG LOG_STREAM(err, log_engine)
@@ -262,6 +263,54 @@ void undo_list::new_side_turn(int side)
 }
 
 
+namespace {
+	/** Rough heap size of @a cfg, in bytes: its nodes, keys and values. */
+	std::size_t approximate_size(const config& cfg)
+	{
+		std::size_t size = sizeof(config);
+		for(const auto& [key, value] : cfg.attribute_range()) {
+			size += sizeof(config::attribute) + key.size() + value.str().size();
+		}
+		for(const config::any_child child : cfg.all_children_range()) {
+			size += child.key.size() + approximate_size(child.cfg);
+		}
+		return size;
+	}
+}
+
+/**
+ * Returns the sizes of the undo and redo stacks, and roughly how much memory they use.
+ */
+undo_list::stats undo_list::get_stats() const
+{
+	stats res;
+	res.undos = undos_.size();
+	res.redos = redos_.size();
+
+	// Command blocks shared by several events are only counted once.
+	std::set<const config*> command_blocks;
+	for(const auto& action_ptr : undos_) {
+		res.undo_bytes += sizeof(undo_action);
+		if(const auto action = dynamic_cast<const shroud_clearing_action*>(action_ptr.get())) {
+			res.undo_bytes += action->route.capacity() * sizeof(map_location);
+		}
+		if(const auto action = dynamic_cast<const undo_action*>(action_ptr.get())) {
+			for(const undo_event& event : action->umc_commands_undo) {
+				res.undo_bytes += sizeof(undo_event) + approximate_size(event.data);
+				if(command_blocks.insert(event.commands.get()).second) {
+					res.wml_bytes += approximate_size(*event.commands);
+				}
+			}
+		}
+	}
+	res.undo_bytes += res.wml_bytes;
+
+	for(const auto& redo : redos_) {
+		res.redo_bytes += approximate_size(*redo);
+	}
+	return res;
+}
+
 /**
  * Read the undo_list from the provided config.
  * Currently, this is only used when the undo_list is empty, but in theory
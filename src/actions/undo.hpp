@@ -88,6 +88,18 @@ public:
 	void new_side_turn(int side);
 	/** Returns true if the player has performed any actions this turn. */
 	bool player_acted() const { return committed_actions_ || !undos_.empty(); }
+	/** Sizes of the undo and redo stacks, as shown in the debug overlay. */
+	struct stats {
+		std::size_t undos = 0;
+		std::size_t redos = 0;
+		/** Approximate memory used by the undoable actions, in bytes, including wml_bytes. */
+		std::size_t undo_bytes = 0;
+		/** Approximate memory used by the distinct [on_undo] command blocks, in bytes. */
+		std::size_t wml_bytes = 0;
+		/** Approximate memory used by the redo stack, in bytes. */
+		std::size_t redo_bytes = 0;
+	};
+	stats get_stats() const;
 	/** Read the undo_list from the provided config. */
 	void read(const config & cfg);
 	/** Write the undo_list into the provided config. */
@@ -25,13 +25,59 @@
 #include <cassert>
 #include <iterator>
 #include <algorithm>
+#include <unordered_map>
 
 namespace actions
 {
 
+namespace {
+	/**
+	 * Command blocks held by live undo events, by content hash, see
+	 * undo_event::share_commands(). Only blocks with the same hash are
+	 * compared in full.
+	 */
+	std::unordered_multimap<std::string, std::weak_ptr<const config>> shared_commands;
+
+	/** Size of shared_commands after it was last pruned. */
+	std::size_t pruned_size = 0;
+
+	void prune_shared_commands()
+	{
+		for(auto i = shared_commands.begin(); i != shared_commands.end();) {
+			if(i->second.expired()) {
+				i = shared_commands.erase(i);
+			} else {
+				++i;
+			}
+		}
+		pruned_size = shared_commands.size();
+	}
+}
+
+std::shared_ptr<const config> undo_event::share_commands(const config& cmds)
+{
+	const std::string hash = cmds.hash();
+	const auto [begin, end] = shared_commands.equal_range(hash);
+	for(auto i = begin; i != end; ++i) {
+		std::shared_ptr<const config> res = i->second.lock();
+		if(res && *res == cmds) {
+			return res;
+		}
+	}
+
+	// Drop the blocks of discarded undo actions once they could make up half of the entries.
+	if(shared_commands.size() >= 2 * pruned_size + 16) {
+		prune_shared_commands();
+	}
+
+	auto res = std::make_shared<const config>(cmds);
+	shared_commands.emplace(hash, res);
+	return res;
+}
+
 undo_event::undo_event(int fcn_idx, const config& args, const game_events::queued_event& ctx)
 	: lua_idx(fcn_idx)
-	, commands(args)
+	, commands(share_commands(args))
 	, data(ctx.data)
 	, loc1(ctx.loc1)
 	, loc2(ctx.loc2)
@@ -51,7 +97,7 @@ undo_event::undo_event(int fcn_idx, const config& args, const game_events::queue
 }
 
 undo_event::undo_event(const config& cmds, const game_events::queued_event& ctx)
-	: commands(cmds)
+	: commands(share_commands(cmds))
 	, data(ctx.data)
 	, loc1(ctx.loc1)
 	, loc2(ctx.loc2)
@@ -71,7 +117,7 @@ undo_event::undo_event(const config& cmds, const game_events::queued_event& ctx)
 }
 
 undo_event::undo_event(const config& first, const config& second, const config& weapons, const config& cmds)
-	: commands(cmds)
+	: commands(share_commands(cmds))
 	, data(weapons)
 	, loc1(first["x"], first["y"], wml_loc())
 	, loc2(second["x"], second["y"], wml_loc())
@@ -141,9 +187,9 @@ namespace {
 
 		game_events::queued_event q(tag, "", map_location(x1, y1, wml_loc()), map_location(x2, y2, wml_loc()), e.data);
 		if(e.lua_idx.has_value()) {
-			resources::lua_kernel->run_wml_event(*e.lua_idx, vconfig(e.commands), q);
+			resources::lua_kernel->run_wml_event(*e.lua_idx, vconfig(*e.commands), q);
 		} else {
-			resources::lua_kernel->run_wml_action("command", vconfig(e.commands), q);
+			resources::lua_kernel->run_wml_action("command", vconfig(*e.commands), q);
 		}
 		sound::commit_music_changes();
 
@@ -187,7 +233,7 @@ void undo_action::write_event_vector(const event_vector& vec, config& cfg, const
 		config& first = entry.add_child("filter");
 		config& second = entry.add_child("filter_second");
 		entry.add_child("data", evt.data);
-		entry.add_child("command", evt.commands);
+		entry.add_child("command", *evt.commands);
 		// First location
 		first["filter_x"] = evt.filter_loc1.wml_x();
 		first["filter_y"] = evt.filter_loc1.wml_y();
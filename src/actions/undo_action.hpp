@@ -15,6 +15,7 @@
 
 #pragma once
 
+#include <memory>
 #include <optional>
 #include "map/location.hpp"
 #include "synced_context.hpp"
@@ -24,13 +25,24 @@ namespace actions {
 
 	struct undo_event {
 		std::optional<int> lua_idx;
-		config commands, data;
+		/**
+		 * The [on_undo] commands. Events fired by several actions of a turn
+		 * share one copy, see undo_event::share_commands().
+		 */
+		std::shared_ptr<const config> commands;
+		config data;
 		map_location loc1, loc2, filter_loc1, filter_loc2;
 		std::size_t uid1, uid2;
 		std::string id1, id2;
 		undo_event(int fcn_idx, const config& args, const game_events::queued_event& ctx);
 		undo_event(const config& cmds, const game_events::queued_event& ctx);
 		undo_event(const config& first, const config& second, const config& weapons, const config& cmds);
+
+		/**
+		 * Returns a shared copy of @a cmds, reusing the copy held by another
+		 * live undo_event if its contents are equal.
+		 */
+		static std::shared_ptr<const config> share_commands(const config& cmds);
 	};
 
 	/**
@@ -46,6 +46,51 @@ namespace ai {
 
 namespace ai_default_rca {
 
+namespace {
+
+/**
+ * Tries to dispatch unit @a u to a village it can reach, moving units that
+ * were dispatched earlier to other villages if that frees one up.
+ *
+ * @param matrix                  Which villages each unit can reach.
+ * @param village_unit            The unit dispatched to each village, or the
+ *                                number of units if none.
+ * @param visited                 Villages already tried for this unit.
+ *
+ * @returns                       Whether the unit was dispatched.
+ */
+bool assign_unit(std::size_t u, const std::vector<boost::dynamic_bitset<>>& matrix,
+	std::vector<std::size_t>& village_unit, boost::dynamic_bitset<>& visited)
+{
+	for(std::size_t v = matrix[u].find_first(); v != boost::dynamic_bitset<>::npos; v = matrix[u].find_next(v)) {
+		if(visited[v]) {
+			continue;
+		}
+
+		visited[v] = true;
+		if(village_unit[v] == matrix.size() || assign_unit(village_unit[v], matrix, village_unit, visited)) {
+			village_unit[v] = u;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+} // namespace
+
+std::vector<std::size_t> match_units_to_villages(const std::vector<boost::dynamic_bitset<>>& reach,
+	std::size_t village_count, const std::vector<std::size_t>& order)
+{
+	std::vector<std::size_t> village_unit(village_count, reach.size());
+	for(std::size_t u : order) {
+		boost::dynamic_bitset<> visited(village_count);
+		assign_unit(u, reach, village_unit, visited);
+	}
+
+	return village_unit;
+}
+
 //==============================================================
 
 goto_phase::goto_phase( rca_context &context, const config &cfg )
@@ -670,7 +715,6 @@ void get_villages_phase::find_villages(
 
 	std::size_t min_distance = 100000;
 	const gamemap &map_ = resources::gameboard->map();
-	std::vector<team> &teams_ = resources::gameboard->teams();
 
 	// When a unit is dispatched we need to make sure we don't
 	// dispatch this unit a second time, so store them here.
@@ -698,19 +742,9 @@ void get_villages_phase::find_villages(
 			continue;
 		}
 
-		bool want_village = true, owned = false;
-		for(std::size_t n = 0; n != teams_.size(); ++n) {
-			owned = teams_[n].owns_village(current_loc);
-			if(owned && !current_team().is_enemy(n+1)) {
-				want_village = false;
-			}
-
-			if(owned) {
-				break;
-			}
-		}
-
-		if(want_village == false) {
+		const int owner = resources::gameboard->village_owner(current_loc);
+		const bool owned = owner != 0;
+		if(owned && !current_team().is_enemy(owner)) {
 			continue;
 		}
 
@@ -1130,147 +1164,43 @@ void get_villages_phase::dispatch_complex(
 		++src_itor;
 	}
 
-	// ***** ***** Do all permutations.
-	// Now walk through all possible permutations
-	// - test whether the suggestion is possible
-	// - does it result in max_villages
-	//   - dispatch and ready
-	// - is it's result better as the last best
-	//   - store
-	std::vector<std::pair<map_location, map_location>> best_result;
-
-	// Bruteforcing all possible permutations can result in a slow game.
-	// So there needs to be a balance between the best possible result and
-	// not too slow. From the test (at the end of the file) a good number is
-	// picked. In general we shouldn't reach this point too often if we do
-	// there are a lot of villages which are unclaimed and a lot of units
-	// to claim them.
-	const std::size_t max_options = 8;
-	if(unit_count >= max_options && village_count >= max_options) {
-
-		DBG_AI_TESTING_AI_DEFAULT << "Too many units " << unit_count << " and villages "
-			<< village_count<<" found, evaluate only the first "
-			<< max_options << " options;";
-
-		std::vector<std::size_t> perm (max_options, 0);
-		for(std::size_t i =0; i < max_options; ++i) {
-			perm[i] = i;
-		}
-		while(std::next_permutation(perm.begin(), perm.end())) {
-
-			// Get result for current permutation.
-			std::vector<std::pair<map_location,map_location>> result;
-			for(std::size_t u = 0; u < max_options; ++u) {
-				if(matrix[u][perm[u]]) {
-					result.emplace_back(villages[perm[u]], units[u]);
-
-				}
-			}
-			if(result.size() == max_result) {
-				best_result.swap(result);
-				break;
-			}
-
-			if(result.size() > best_result.size()) {
-				best_result.swap(result);
-			}
-		}
-		// End of loop no optimal found, assign the best
-		moves.insert(moves.end(), best_result.begin(), best_result.end());
-
-		// Clean up the reachmap for dispatched units.
-		for(const auto& unit_village_pair : best_result) {
-			reachmap.erase(unit_village_pair.second);
-		}
-
-		// Try to dispatch whatever is left
-		dispatch(reachmap, moves);
-		return;
-
-	} else if(unit_count <= village_count) {
-
-		DBG_AI_TESTING_AI_DEFAULT << "Unit major";
-
-		std::vector<std::size_t> perm (unit_count, 0);
-		for(std::size_t i =0; i < unit_count; ++i) {
-			perm[i] = i;
-		}
-		while(std::next_permutation(perm.begin(), perm.end())) {
-			// Get result for current permutation.
-			std::vector<std::pair<map_location,map_location>> result;
-			for(std::size_t u = 0; u < unit_count; ++u) {
-				if(matrix[u][perm[u]]) {
-					result.emplace_back(villages[perm[u]], units[u]);
-
-				}
-			}
-			if(result.size() == max_result) {
-				moves.insert(moves.end(), result.begin(), result.end());
-				reachmap.clear();
-				return;
-			}
-
-			if(result.size() > best_result.size()) {
-				best_result.swap(result);
-			}
-		}
-		// End of loop no optimal found, assign the best
-		moves.insert(moves.end(), best_result.begin(), best_result.end());
-
-		// clean up the reachmap we need to test whether the leader is still there
-		// and if so remove him manually to get him dispatched.
-		for(const auto& unit_village_pair : best_result) {
-			reachmap.erase(unit_village_pair.second);
-		}
-		treachmap::iterator unit = reachmap.find(leader_loc_);
-		if(unit != reachmap.end()) {
-			unit->second.clear();
-			remove_unit(reachmap, moves, unit);
-		}
-		reachmap.clear();
-
-	} else {
+	// ***** ***** Find a maximum matching.
+	// Dispatch as many units as possible, each to a different village. The
+	// assignment is grown along augmenting paths (Kuhn's algorithm), which
+	// finds the largest one in O(units * reach) steps, where trying every
+	// permutation would be factorial.
+	// Try the units who can reach the least villages first.
+	std::vector<std::size_t> order;
+	order.reserve(unit_count);
+	for(const auto& lookup : unit_lookup) {
+		order.push_back(lookup.second);
+	}
 
-		DBG_AI_TESTING_AI_DEFAULT << "Village major";
+	const std::size_t unassigned = unit_count;
+	const std::vector<std::size_t> village_unit = match_units_to_villages(matrix, village_count, order);
 
-		std::vector<std::size_t> perm (village_count, 0);
-		for(std::size_t i =0; i < village_count; ++i) {
-			perm[i] = i;
+	std::size_t dispatched = 0;
+	for(std::size_t v = 0; v < village_count; ++v) {
+		if(village_unit[v] == unassigned) {
+			continue;
 		}
-		while(std::next_permutation(perm.begin(), perm.end())) {
-			// Get result for current permutation.
-			std::vector<std::pair<map_location,map_location>> result;
-			for(std::size_t v = 0; v < village_count; ++v) {
-				if(matrix[perm[v]][v]) {
-					result.emplace_back(villages[v], units[perm[v]]);
 
-				}
-			}
-			if(result.size() == max_result) {
-				moves.insert(moves.end(), result.begin(), result.end());
-				reachmap.clear();
-				return;
-			}
+		DBG_AI_TESTING_AI_DEFAULT << "Dispatched unit at " << units[village_unit[v]] << " to village " << villages[v];
+		moves.emplace_back(villages[v], units[village_unit[v]]);
+		reachmap.erase(units[village_unit[v]]);
+		++dispatched;
+	}
 
-			if(result.size() > best_result.size()) {
-				best_result.swap(result);
-			}
-		}
-		// End of loop no optimal found, assigne the best
-		moves.insert(moves.end(), best_result.begin(), best_result.end());
+	DBG_AI_TESTING_AI_DEFAULT << "Dispatched " << dispatched << " of at most " << max_result << " units.";
 
-		// clean up the reachmap we need to test whether the leader is still there
-		// and if so remove him manually to get him dispatched.
-		for(const auto& unit_village_pair : best_result) {
-			reachmap.erase(unit_village_pair.second);
-		}
-		treachmap::iterator unit = reachmap.find(leader_loc_);
-		if(unit != reachmap.end()) {
-			unit->second.clear();
-			remove_unit(reachmap, moves, unit);
-		}
-		reachmap.clear();
+	// The matching is maximum, so the units left can't reach any village that
+	// is still free. If the leader is one of them, send him to the keep.
+	treachmap::iterator unit = reachmap.find(leader_loc_);
+	if(unit != reachmap.end()) {
+		unit->second.clear();
+		remove_unit(reachmap, moves, unit);
 	}
+	reachmap.clear();
 }
 
 void get_villages_phase::full_dispatch(treachmap& reachmap, tmoves& moves)
@@ -24,10 +24,28 @@
 
 #include "ai/composite/rca.hpp"
 
+#include <boost/dynamic_bitset.hpp>
+
+#include <vector>
+
 namespace ai {
 
 namespace ai_default_rca {
 
+/**
+ * Dispatches as many units as possible, each to a different village it can
+ * reach (a maximum bipartite matching, found with Kuhn's algorithm).
+ *
+ * @param reach                   For every unit, the villages it can reach.
+ * @param village_count           The number of villages.
+ * @param order                   The units, in the order they are tried.
+ *
+ * @returns                       For every village, the unit dispatched to it,
+ *                                or reach.size() if none.
+ */
+std::vector<std::size_t> match_units_to_villages(const std::vector<boost::dynamic_bitset<>>& reach,
+	std::size_t village_count, const std::vector<std::size_t>& order);
+
 //============================================================================
 
 class goto_phase : public candidate_action {
@@ -31,6 +31,9 @@
 #include "pathfind/teleport.hpp"
 
 #include <deque>
+#include <map>
+#include <queue>
+#include <set>
 
 namespace ai {
 
@@ -83,6 +86,91 @@ private:
 	const bool avoid_enemies_;
 };
 
+/**
+ * Route costs towards a single target for every unit that moves like the one
+ * the field was created for.
+ *
+ * The costs are computed backwards from the target with Dijkstra's algorithm,
+ * so one field answers a_star_search()'s move_cost for any starting hex. It
+ * is only expanded as far as needed by the queries made so far.
+ */
+class target_cost_field
+{
+public:
+	target_cost_field(const map_location& target, const move_cost_calculator& calc,
+			double stop_at, const gamemap& map)
+		: calc_(calc)
+		, stop_at_(stop_at)
+		, map_(map)
+		, cost_(static_cast<std::size_t>(map.w()) * map.h(), stop_at + 1)
+		, settled_(cost_.size(), false)
+		, queue_()
+	{
+		// Same as a_star_search(), which gives up if the target itself is too expensive.
+		if(calc_.cost(target, 0) < stop_at_) {
+			cost_[index(target)] = 0;
+			queue_.emplace(0, target);
+		}
+	}
+
+	/** Cost of the cheapest route from @a src to the target, getNoPathValue() if there is none. */
+	double cost_from(const map_location& src)
+	{
+		const std::size_t i = index(src);
+		while(!settled_[i] && !queue_.empty()) {
+			expand();
+		}
+
+		return settled_[i] && cost_[i] <= stop_at_ ? cost_[i] : calc_.getNoPathValue();
+	}
+
+private:
+	typedef std::pair<double, map_location> queue_entry;
+
+	std::size_t index(const map_location& loc) const
+	{
+		return static_cast<std::size_t>(loc.y) * map_.w() + loc.x;
+	}
+
+	void expand()
+	{
+		const queue_entry top = queue_.top();
+		queue_.pop();
+
+		const std::size_t i = index(top.second);
+		if(settled_[i] || top.first > cost_[i]) {
+			return;
+		}
+		settled_[i] = true;
+
+		// Stepping from a neighbor onto this hex costs what a forward search pays to enter it.
+		const double entered = top.first + calc_.cost(top.second, 0);
+		for(const map_location& adj : get_adjacent_tiles(top.second)) {
+			if(!map_.on_board(adj)) {
+				continue;
+			}
+
+			const std::size_t j = index(adj);
+			if(entered < cost_[j]) {
+				cost_[j] = entered;
+				queue_.emplace(entered, adj);
+			}
+		}
+	}
+
+	struct queue_compare
+	{
+		bool operator()(const queue_entry& a, const queue_entry& b) const { return a.first > b.first; }
+	};
+
+	const move_cost_calculator calc_;
+	const double stop_at_;
+	const gamemap& map_;
+	std::vector<double> cost_;
+	std::vector<bool> settled_;
+	std::priority_queue<queue_entry, std::vector<queue_entry>, queue_compare> queue_;
+};
+
 class remove_wrong_targets {
 public:
 	remove_wrong_targets(const readonly_context &context)
@@ -376,6 +464,20 @@ std::pair<map_location,map_location> move_to_targets_phase::choose_move(std::vec
 
 	if(simple_targeting == false) {
 		LOG_AI << "complex targeting...";
+
+		// Units whose movement costs agree on every terrain of the map share a
+		// cost field towards the target instead of each running their own search.
+		// Scouts and teleporting units still get a full search: a scout's rating
+		// depends on the route itself and the field does not know about tunnels.
+		std::set<t_translation::terrain_code> map_terrains;
+		for(int x = 0; x < map_.w(); ++x) {
+			for(int y = 0; y < map_.h(); ++y) {
+				map_terrains.insert(map_.get_terrain(map_location(x, y)));
+			}
+		}
+		std::map<std::vector<int>, target_cost_field> cost_fields;
+		bool best_route_pending = false;
+
 		//now see if any other unit can put a better bid forward
 		for(++u; u != units_.end(); ++u) {
 			if (u->side() != get_side() || (u->can_recruit() && !is_keep_ignoring_leader(u->id())) ||
@@ -394,6 +496,40 @@ std::pair<map_location,map_location> move_to_targets_phase::choose_move(std::vec
 			// as it can cause the AI to give up on searches and just do nothing.
 			const double locStopValue = 500.0;
 			const pathfind::teleport_map allowed_teleports = pathfind::get_teleport_locations(*u, current_team());
+
+			if(u->usage() != "scout" && allowed_teleports.empty()) {
+				std::vector<int> movement_costs;
+				movement_costs.reserve(map_terrains.size() + 1);
+				movement_costs.push_back(u->total_movement());
+				for(const t_translation::terrain_code& terrain : map_terrains) {
+					const int cost = u->movement_cost(terrain);
+					movement_costs.push_back(cost > u->total_movement() ? -1 : cost);
+				}
+
+				auto field = cost_fields.find(movement_costs);
+				if(field == cost_fields.end()) {
+					field = cost_fields.emplace(std::move(movement_costs),
+						target_cost_field(best_target->loc, calc, locStopValue, map_)).first;
+				}
+
+				const double cost = field->second.cost_from(u->get_location());
+				if(cost > locStopValue) {
+					continue;
+				}
+
+				// Only the rating is needed for now, the route is found once the unit is picked.
+				pathfind::plain_route cost_route;
+				cost_route.move_cost = static_cast<int>(cost);
+				double rating = rate_target(*best_target, u, dstsrc, enemy_dstsrc, cost_route);
+
+				if(best == units_.end() || rating > best_rating) {
+					best_rating = rating;
+					best = u;
+					best_route_pending = true;
+				}
+				continue;
+			}
+
 			pathfind::plain_route cur_route = pathfind::a_star_search(u->get_location(), best_target->loc, locStopValue, calc, map_.w(), map_.h(), &allowed_teleports);
 
 			if(cur_route.steps.empty()) {
@@ -406,9 +542,16 @@ std::pair<map_location,map_location> move_to_targets_phase::choose_move(std::vec
 				best_rating = rating;
 				best = u;
 				best_route = cur_route;
+				best_route_pending = false;
 			}
 		}
 
+		if(best_route_pending) {
+			const move_cost_calculator calc(*best, map_, units_, enemy_dstsrc);
+			const pathfind::teleport_map allowed_teleports = pathfind::get_teleport_locations(*best, current_team());
+			best_route = pathfind::a_star_search(best->get_location(), best_target->loc, 500.0, calc, map_.w(), map_.h(), &allowed_teleports);
+		}
+
 		LOG_AI << "done complex targeting...";
 	} else {
 		u = units_.end();
@@ -22,11 +22,13 @@
 #include <cstring>
 
 #include "ai/lua/core.hpp"
+#include "ai/lua/location_set.hpp"
 #include "ai/composite/aspect.hpp"
 #include "scripting/lua_unit.hpp"
 #include "scripting/push_check.hpp"
 #include "ai/lua/lua_object.hpp" // (Nephro)
 
+#include "game_board.hpp"
 #include "log.hpp"
 #include "pathfind/pathfind.hpp"
 #include "play_controller.hpp"
@@ -45,6 +47,7 @@ static lg::log_domain log_ai_engine_lua("ai/engine/lua");
 #define ERR_LUA LOG_STREAM(err, log_ai_engine_lua)
 
 static char const aisKey[] = "ai contexts";
+static char const locationsetKey[] = "ai location set";
 
 namespace ai {
 
@@ -355,15 +358,241 @@ static int cfun_ai_get_attacks(lua_State *L)
 	// Unlike the other aspect fetchers, this one is not deprecated!
 	// This is because ai.aspects.attacks returns the viable units but this returns a full attack analysis
 	const ai::attacks_vector& attacks = get_readonly_context(L).get_attacks();
-	lua_createtable(L, attacks.size(), 0);
+
+	// An optional location only returns the attack combinations against that hex,
+	// so that Lua AIs don't have to filter every analysis themselves.
+	map_location target;
+	const bool filter_target = !lua_isnoneornil(L, 1);
+	if(filter_target) {
+		target = luaW_checklocation(L, 1);
+	}
+
+	lua_createtable(L, filter_target ? 0 : attacks.size(), 0);
 	int table_index = lua_gettop(L);
 
-	ai::attacks_vector::const_iterator it = attacks.begin();
-	for (int i = 1; it != attacks.end(); ++it, ++i)
-	{
-		push_attack_analysis(L, *it);
+	int i = 1;
+	for(const attack_analysis& aa : attacks) {
+		if(filter_target && aa.target != target) {
+			continue;
+		}
+
+		push_attack_analysis(L, aa);
+
+		lua_rawseti(L, table_index, i++);
+	}
+	return 1;
+}
+
+/**
+ * For every hex that an enemy unit could attack next turn, how many enemy
+ * units could do so and their total hitpoints. Returns an array of tables
+ * with the fields x, y, units and hitpoints.
+ */
+static int cfun_ai_get_enemy_attack_map(lua_State *L)
+{
+	const move_map& enemy_srcdst = get_readonly_context(L).get_enemy_srcdst();
+	const gamemap& map = resources::gameboard->map();
+	const unit_map& units = resources::gameboard->units();
+
+	const std::size_t size = static_cast<std::size_t>(map.w()) * map.h();
+	std::vector<int> attackers(size, 0);
+	std::vector<int> hitpoints(size, 0);
+	// The last enemy counted on each hex (1-based), so that no enemy is counted twice.
+	std::vector<std::size_t> counted(size, 0);
+	std::vector<std::size_t> hexes;
+	std::size_t enemy = 0;
+
+	for(auto it = enemy_srcdst.begin(); it != enemy_srcdst.end(); ) {
+		const map_location src = it->first;
+		++enemy;
+		const unit_map::const_iterator u = units.find(src);
+		const int hp = u != units.end() ? u->hitpoints() : 0;
+
+		for(; it != enemy_srcdst.end() && it->first == src; ++it) {
+			for(const map_location& adj : get_adjacent_tiles(it->second)) {
+				if(!map.on_board(adj)) {
+					continue;
+				}
+
+				const std::size_t i = static_cast<std::size_t>(adj.y) * map.w() + adj.x;
+				if(counted[i] == enemy) {
+					continue;
+				}
+
+				if(attackers[i] == 0) {
+					hexes.push_back(i);
+				}
+				counted[i] = enemy;
+				++attackers[i];
+				hitpoints[i] += hp;
+			}
+		}
+	}
+
+	lua_createtable(L, hexes.size(), 0);
+	int n = 1;
+	for(std::size_t i : hexes) {
+		lua_createtable(L, 0, 4);
+		const map_location loc(i % map.w(), i / map.w());
+		lua_pushinteger(L, loc.wml_x());
+		lua_setfield(L, -2, "x");
+		lua_pushinteger(L, loc.wml_y());
+		lua_setfield(L, -2, "y");
+		lua_pushinteger(L, attackers[i]);
+		lua_setfield(L, -2, "units");
+		lua_pushinteger(L, hitpoints[i]);
+		lua_setfield(L, -2, "hitpoints");
+		lua_rawseti(L, -2, n++);
+	}
+	return 1;
+}
+
+static void push_location_set(lua_State* L, location_set locs);
+
+/** A location set argument, either a location set or an array of locations. */
+static location_set check_location_set(lua_State* L, int index)
+{
+	if(void* p = luaL_testudata(L, index, locationsetKey)) {
+		return *static_cast<location_set*>(p);
+	}
+	return location_set(luaW_check_locationset(L, index));
+}
+
+static location_set& get_location_set(lua_State* L, int index)
+{
+	return *static_cast<location_set*>(luaL_checkudata(L, index, locationsetKey));
+}
+
+static int impl_location_set_collect(lua_State* L)
+{
+	get_location_set(L, 1).~location_set();
+	return 0;
+}
+
+static int impl_location_set_len(lua_State* L)
+{
+	lua_pushinteger(L, get_location_set(L, 1).size());
+	return 1;
+}
+
+static int impl_location_set_contains(lua_State* L)
+{
+	const location_set& locs = get_location_set(L, 1);
+	lua_pushboolean(L, locs.contains(luaW_checklocation(L, 2)));
+	return 1;
+}
+
+static int impl_location_set_union(lua_State* L)
+{
+	push_location_set(L, check_location_set(L, 1).union_with(check_location_set(L, 2)));
+	return 1;
+}
+
+static int impl_location_set_intersection(lua_State* L)
+{
+	push_location_set(L, check_location_set(L, 1).intersection(check_location_set(L, 2)));
+	return 1;
+}
+
+static int impl_location_set_difference(lua_State* L)
+{
+	push_location_set(L, check_location_set(L, 1).difference(check_location_set(L, 2)));
+	return 1;
+}
+
+static int impl_location_set_next(lua_State* L)
+{
+	const location_set& locs = get_location_set(L, lua_upvalueindex(1));
+	const lua_Integer i = lua_tointeger(L, lua_upvalueindex(2));
+	if(i < 0 || static_cast<std::size_t>(i) >= locs.size()) {
+		return 0;
+	}
+
+	lua_pushinteger(L, i + 1);
+	lua_replace(L, lua_upvalueindex(2));
+	const map_location& loc = *(locs.begin() + i);
+	lua_pushinteger(L, loc.wml_x());
+	lua_pushinteger(L, loc.wml_y());
+	return 2;
+}
+
+/** Iterates over the locations of the set: for x, y in locs:iter() do ... end */
+static int impl_location_set_iter(lua_State* L)
+{
+	get_location_set(L, 1);
+	lua_pushvalue(L, 1);
+	lua_pushinteger(L, 0);
+	lua_pushcclosure(L, &impl_location_set_next, 2);
+	return 1;
+}
+
+static void push_location_set(lua_State* L, location_set locs)
+{
+	new(L) location_set(std::move(locs));
+	if(luaL_newmetatable(L, locationsetKey)) {
+		static luaL_Reg const methods[] = {
+			{ "contains", &impl_location_set_contains },
+			{ "union", &impl_location_set_union },
+			{ "intersect", &impl_location_set_intersection },
+			{ "difference", &impl_location_set_difference },
+			{ "iter", &impl_location_set_iter },
+			{ nullptr, nullptr }
+		};
+		static luaL_Reg const callbacks[] = {
+			{ "__gc", &impl_location_set_collect },
+			{ "__len", &impl_location_set_len },
+			{ "__add", &impl_location_set_union },
+			{ "__mul", &impl_location_set_intersection },
+			{ "__sub", &impl_location_set_difference },
+			{ "__pairs", &impl_location_set_iter },
+			{ nullptr, nullptr }
+		};
+		luaL_setfuncs(L, callbacks, 0);
+		lua_newtable(L);
+		luaL_setfuncs(L, methods, 0);
+		lua_setfield(L, -2, "__index");
+		lua_pushstring(L, locationsetKey);
+		lua_setfield(L, -2, "__metatable");
+	}
+	lua_setmetatable(L, -2);
+}
+
+/**
+ * Creates a location set from an optional array of locations. The sets support
+ * union (+), intersection (*) and difference (-), with either another set or
+ * an array of locations, as well as the methods of the same names, contains,
+ * iter and the length operator.
+ */
+static int cfun_ai_location_set(lua_State *L)
+{
+	push_location_set(L, lua_isnoneornil(L, 1) ? location_set() : check_location_set(L, 1));
+	return 1;
+}
 
-		lua_rawseti(L, table_index, i);
+/**
+ * The hex distance from every hex of the map to the nearest of the given
+ * locations, up to an optional maximum. Returns an array of tables with the
+ * fields x, y and distance, nearest first.
+ */
+static int cfun_ai_get_distance_map(lua_State *L)
+{
+	const location_set sources = check_location_set(L, 1);
+	const int max_distance = luaL_optinteger(L, 2, -1);
+	const gamemap& map = resources::gameboard->map();
+
+	const std::vector<std::pair<map_location, int>> distances = distance_map(map.w(), map.h(), sources, max_distance);
+
+	lua_createtable(L, distances.size(), 0);
+	int n = 1;
+	for(const auto& [loc, distance] : distances) {
+		lua_createtable(L, 0, 3);
+		lua_pushinteger(L, loc.wml_x());
+		lua_setfield(L, -2, "x");
+		lua_pushinteger(L, loc.wml_y());
+		lua_setfield(L, -2, "y");
+		lua_pushinteger(L, distance);
+		lua_setfield(L, -2, "distance");
+		lua_rawseti(L, -2, n++);
 	}
 	return 1;
 }
@@ -911,6 +1140,10 @@ static void generate_and_push_ai_table(lua_State* L, ai::engine_lua* engine) {
 		{ "get_targets", &cfun_ai_get_targets },
 		// Attack analysis
 		{ "get_attacks", &cfun_ai_get_attacks },
+		{ "get_enemy_attack_map", &cfun_ai_get_enemy_attack_map },
+		// Location sets and distances
+		{ "location_set", &cfun_ai_location_set },
+		{ "get_distance_map", &cfun_ai_get_distance_map },
 		// Deprecated aspects (don't add anything new here!)
 		{ "get_aggression", &cfun_ai_get_aggression },
 		{ "get_avoid", &cfun_ai_get_avoid },
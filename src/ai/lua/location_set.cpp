@@ -0,0 +1,102 @@
+/*
+	Copyright (C) 2024 - 2024
+	by the Battle for Wesnoth developers
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#include "ai/lua/location_set.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace ai {
+
+location_set::location_set(std::vector<map_location> locs)
+	: locs_(std::move(locs))
+{
+	std::sort(locs_.begin(), locs_.end());
+	locs_.erase(std::unique(locs_.begin(), locs_.end()), locs_.end());
+}
+
+location_set::location_set(const std::set<map_location>& locs)
+	: locs_(locs.begin(), locs.end())
+{
+}
+
+bool location_set::contains(const map_location& loc) const
+{
+	return std::binary_search(locs_.begin(), locs_.end(), loc);
+}
+
+location_set location_set::union_with(const location_set& other) const
+{
+	location_set result;
+	result.locs_.reserve(locs_.size() + other.locs_.size());
+	std::set_union(locs_.begin(), locs_.end(), other.locs_.begin(), other.locs_.end(), std::back_inserter(result.locs_));
+	return result;
+}
+
+location_set location_set::intersection(const location_set& other) const
+{
+	location_set result;
+	std::set_intersection(locs_.begin(), locs_.end(), other.locs_.begin(), other.locs_.end(), std::back_inserter(result.locs_));
+	return result;
+}
+
+location_set location_set::difference(const location_set& other) const
+{
+	location_set result;
+	std::set_difference(locs_.begin(), locs_.end(), other.locs_.begin(), other.locs_.end(), std::back_inserter(result.locs_));
+	return result;
+}
+
+std::vector<std::pair<map_location, int>> distance_map(int width, int height, const location_set& sources, int max_distance)
+{
+	std::vector<std::pair<map_location, int>> result;
+	if(width <= 0 || height <= 0) {
+		return result;
+	}
+
+	// A breadth-first search from all the sources at once: every hex is
+	// reached first from its nearest source, so each is visited only once.
+	std::vector<bool> reached(static_cast<std::size_t>(width) * height, false);
+	for(const map_location& loc : sources) {
+		if(loc.valid(width, height)) {
+			reached[static_cast<std::size_t>(loc.y) * width + loc.x] = true;
+			result.emplace_back(loc, 0);
+		}
+	}
+
+	for(std::size_t next = 0; next < result.size(); ++next) {
+		const auto [loc, distance] = result[next];
+		if(max_distance >= 0 && distance >= max_distance) {
+			// The queue is in order of distance, so nothing after this can be expanded either.
+			break;
+		}
+
+		for(const map_location& adj : get_adjacent_tiles(loc)) {
+			if(!adj.valid(width, height)) {
+				continue;
+			}
+
+			const std::size_t i = static_cast<std::size_t>(adj.y) * width + adj.x;
+			if(!reached[i]) {
+				reached[i] = true;
+				result.emplace_back(adj, distance + 1);
+			}
+		}
+	}
+
+	return result;
+}
+
+} // of namespace ai
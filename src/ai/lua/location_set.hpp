@@ -0,0 +1,71 @@
+/*
+	Copyright (C) 2024 - 2024
+	by the Battle for Wesnoth developers
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+/**
+ * @file
+ * Location sets and distance maps for the Lua AI.
+ */
+
+#pragma once
+
+#include "map/location.hpp"
+
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace ai {
+
+/**
+ * A set of map locations, kept sorted so that the set operations
+ * are a single merge instead of one lookup per location.
+ */
+class location_set
+{
+public:
+	using const_iterator = std::vector<map_location>::const_iterator;
+
+	location_set() = default;
+	explicit location_set(std::vector<map_location> locs);
+	explicit location_set(const std::set<map_location>& locs);
+
+	bool contains(const map_location& loc) const;
+
+	location_set union_with(const location_set& other) const;
+	location_set intersection(const location_set& other) const;
+	location_set difference(const location_set& other) const;
+
+	const_iterator begin() const { return locs_.begin(); }
+	const_iterator end() const { return locs_.end(); }
+	std::size_t size() const { return locs_.size(); }
+	bool empty() const { return locs_.empty(); }
+
+	bool operator==(const location_set& other) const { return locs_ == other.locs_; }
+	bool operator!=(const location_set& other) const { return locs_ != other.locs_; }
+
+private:
+	std::vector<map_location> locs_;
+};
+
+/**
+ * The hex distance from every on-board location of a @a width x @a height map
+ * to the nearest of @a sources, in the order of increasing distance.
+ * Sources outside the map are ignored.
+ *
+ * @param max_distance Locations further away are left out; negative for no limit.
+ */
+std::vector<std::pair<map_location, int>> distance_map(int width, int height, const location_set& sources, int max_distance = -1);
+
+} // of namespace ai
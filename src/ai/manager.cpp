@@ -21,12 +21,14 @@
 #include "ai/manager.hpp"
 
 #include "config.hpp"             // for config, etc
+#include "draw_manager.hpp"
 #include "game_events/pump.hpp"
 #include "log.hpp"
 #include "map/location.hpp"       // for map_location
 #include "resources.hpp"
 #include "serialization/string_utils.hpp"
 #include "tod_manager.hpp"
+#include "video.hpp"
 
 #include "ai/composite/ai.hpp"             // for ai_composite
 #include "ai/composite/component.hpp"      // for component_manager
@@ -421,9 +423,13 @@ void manager::raise_user_interact() {
 		return;
 	}
 
-	const int interact_time = 30;
+	// Yield to the main loop whenever a new frame is due, so animations and
+	// scrolling keep the display's frame rate during long AI turns. Without a
+	// display, or when running tests, nothing is drawn and frames are always
+	// due, so only poll for events now and then.
+	const int interact_time = video::headless() || video::testing() ? 30 : 0;
 	const int time_since_interact = SDL_GetTicks() - last_interact_;
-	if(time_since_interact < interact_time) {
+	if(time_since_interact < interact_time || !draw_manager::frame_due()) {
 		return;
 	}
 
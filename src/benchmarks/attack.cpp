@@ -0,0 +1,85 @@
+/*
+	Copyright (C) 2024 - 2024
+	by the Battle for Wesnoth developers
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#include "benchmarks/benchmark.hpp"
+
+#include "actions/attack.hpp"
+#include "attack_prediction.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+/** Number of fighters, the same as in the -DBENCHMARK harness of attack_prediction.cpp. */
+constexpr unsigned num_units = 50;
+
+/**
+ * Units covering the usual hit point ranges, weapon specials and abilities,
+ * built the same way as the stand-alone attack_prediction.cpp harness does.
+ */
+std::shared_ptr<const std::vector<battle_context_unit_stats>> fighters()
+{
+	auto stats = std::make_shared<std::vector<battle_context_unit_stats>>();
+	stats->reserve(num_units);
+
+	for(unsigned i = 0; i < num_units; ++i) {
+		const unsigned alt = i + 74; // To offset some cycles.
+		const unsigned max_hp = (i * 2) % 23 + (i * 3) % 14 + 25;
+		const unsigned hp = (alt * 5) % max_hp + 1;
+
+		stats->emplace_back(alt % 8 + 2, // damage
+			(alt % 19 + 3) / 4,          // number of strikes
+			hp, max_hp,
+			(i % 6) * 10 + 30, // hit chance
+			(i % 13) % 4 == 0, // drains
+			(i % 11) % 3 == 0, // slows
+			false,             // slowed
+			i % 7 == 0,        // berserk
+			(i % 17) / 2 == 0, // firststrike
+			i % 5 == 0);       // swarm
+	}
+
+	return stats;
+}
+
+/** Every unit attacks the next one. */
+const benchmark::registration combat_fight("combat/fight", [] {
+	const auto stats = fighters();
+	return [stats] {
+		for(unsigned i = 0; i < num_units; ++i) {
+			combatant attacker((*stats)[i]);
+			combatant defender((*stats)[(i + 1) % num_units]);
+			attacker.fight(defender);
+			benchmark::do_not_optimize(defender.hp_dist);
+		}
+	};
+});
+
+/** Every unit is attacked twice in a row, which makes the defender's distribution non-trivial. */
+const benchmark::registration combat_fight_twice("combat/fight_twice", [] {
+	const auto stats = fighters();
+	return [stats] {
+		for(unsigned i = 0; i < num_units; ++i) {
+			combatant defender((*stats)[i]);
+			combatant first((*stats)[(i + 7) % num_units]);
+			combatant second((*stats)[(i + 13) % num_units]);
+			first.fight(defender);
+			second.fight(defender);
+			benchmark::do_not_optimize(defender.hp_dist);
+		}
+	};
+});
+} // anonymous namespace
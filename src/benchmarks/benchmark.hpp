@@ -0,0 +1,149 @@
+/*
+	Copyright (C) 2024 - 2024
+	by the Battle for Wesnoth developers
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * A minimal micro-benchmark framework for the wesnoth_benchmarks program.
+ *
+ * A benchmark is registered at static initialization time with a name and a
+ * setup function. The setup function builds whatever input the benchmark needs
+ * and returns the operation to time, so that the setup cost is never measured.
+ * All inputs are synthetic or generated from fixed seeds, so every run of the
+ * same build measures the same work.
+ *
+ * The operation is first run once to warm up caches, then the number of calls
+ * per sample is chosen so that a sample lasts about sample_time, and the time
+ * per call of every sample is recorded.
+ */
+namespace benchmark
+{
+using clock = std::chrono::steady_clock;
+using nanoseconds = std::chrono::duration<double, std::nano>;
+
+/** The operation timed by a benchmark. */
+using operation = std::function<void()>;
+
+/** Builds the input of a benchmark and returns the operation to time. */
+using setup_function = std::function<operation()>;
+
+struct entry
+{
+	std::string name;
+	setup_function setup;
+};
+
+inline std::vector<entry>& registry()
+{
+	static std::vector<entry> entries;
+	return entries;
+}
+
+/** Registers a benchmark. Names are grouped by the part before the slash, e.g. "config/parse". */
+struct registration
+{
+	registration(const std::string& name, setup_function setup)
+	{
+		registry().push_back({name, std::move(setup)});
+	}
+};
+
+namespace detail
+{
+inline const void* volatile sink = nullptr;
+} // namespace detail
+
+/** Keeps the compiler from optimizing away the computation of @a value. */
+template<typename T>
+inline void do_not_optimize(const T& value)
+{
+	detail::sink = std::addressof(value);
+	std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+
+struct options
+{
+	clock::duration sample_time = std::chrono::milliseconds(50);
+	unsigned samples = 10;
+};
+
+struct result
+{
+	std::string name;
+	std::size_t calls_per_sample = 0;
+	/** Time per call of every sample, in run order. */
+	std::vector<nanoseconds> samples;
+
+	nanoseconds min() const
+	{
+		return *std::min_element(samples.begin(), samples.end());
+	}
+
+	nanoseconds max() const
+	{
+		return *std::max_element(samples.begin(), samples.end());
+	}
+
+	nanoseconds median() const
+	{
+		std::vector<nanoseconds> sorted = samples;
+		std::sort(sorted.begin(), sorted.end());
+
+		const std::size_t half = sorted.size() / 2;
+		return sorted.size() % 2 == 1 ? sorted[half] : (sorted[half - 1] + sorted[half]) / 2;
+	}
+};
+
+/** Runs @a op @a calls times and returns the time taken. */
+inline clock::duration time_calls(const operation& op, std::size_t calls)
+{
+	const clock::time_point start = clock::now();
+	for(std::size_t i = 0; i < calls; ++i) {
+		op();
+	}
+
+	return clock::now() - start;
+}
+
+/** Sets up and measures a single benchmark. */
+inline result measure(const entry& e, const options& opts)
+{
+	const operation op = e.setup();
+
+	result res;
+	res.name = e.name;
+
+	// The warm-up call also tells roughly how many calls fit in a sample.
+	const clock::duration first = std::max(time_calls(op, 1), clock::duration(1));
+	res.calls_per_sample = std::max<std::size_t>(1, opts.sample_time / first);
+
+	for(unsigned i = 0; i < std::max(opts.samples, 1u); ++i) {
+		const nanoseconds elapsed = time_calls(op, res.calls_per_sample);
+		res.samples.push_back(elapsed / static_cast<double>(res.calls_per_sample));
+	}
+
+	return res;
+}
+
+} // namespace benchmark
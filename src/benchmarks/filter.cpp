@@ -0,0 +1,224 @@
+/*
+	Copyright (C) 2024 - 2024
+	by the Battle for Wesnoth developers
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#include "benchmarks/benchmark.hpp"
+#include "benchmarks/synthetic.hpp"
+
+#include "config.hpp"
+#include "filter_context.hpp"
+#include "game_board.hpp"
+#include "game_data.hpp"
+#include "map/map.hpp"
+#include "resources.hpp"
+#include "terrain/filter.hpp"
+#include "tests/utils/game_config_manager_tests.hpp"
+#include "tod_manager.hpp"
+#include "units/filter.hpp"
+#include "units/map.hpp"
+#include "units/types.hpp"
+#include "units/unit.hpp"
+#include "variable.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace
+{
+/** Map size of the filter benchmarks, the size of a large mainline scenario. */
+constexpr int map_size = 64;
+
+/**
+ * A game board with everything filters need, installed as the current
+ * filter context for as long as it lives.
+ *
+ * The map has no terrain type data (that needs the full game config), so the
+ * filters below stick to locations, adjacency and unit properties.
+ */
+class board_filter_context : public filter_context
+{
+public:
+	explicit board_filter_context(const config& level)
+		: board(level)
+		, tod_man(level)
+		, gamedata(level)
+		, old_filter_con_(resources::filter_con)
+		, old_gameboard_(resources::gameboard)
+		, old_gamedata_(resources::gamedata)
+	{
+		resources::filter_con = this;
+		resources::gameboard = &board;
+		resources::gamedata = &gamedata;
+	}
+
+	~board_filter_context()
+	{
+		resources::filter_con = old_filter_con_;
+		resources::gameboard = old_gameboard_;
+		resources::gamedata = old_gamedata_;
+	}
+
+	const display_context& get_disp_context() const override { return board; }
+	const tod_manager& get_tod_man() const override { return tod_man; }
+	const game_data* get_game_data() const override { return &gamedata; }
+	game_lua_kernel* get_lua_kernel() const override { return nullptr; }
+
+	game_board board;
+	tod_manager tod_man;
+	game_data gamedata;
+
+private:
+	filter_context* old_filter_con_;
+	game_board* old_gameboard_;
+	game_data* old_gamedata_;
+};
+
+config synthetic_level()
+{
+	config level;
+	level["map_data"] = benchmark::synthetic_map_data(map_size, map_size);
+	return level;
+}
+
+/** Places @a count units of two types, on four sides, on random hexes of the board. */
+void place_units(game_board& board, std::size_t count)
+{
+	// Loads the unit data of the test config, like the unit map tests do.
+	test_utils::get_test_config_ref();
+
+	static const auto make_type = [](const std::string& id, int level) {
+		config cfg;
+		cfg["id"] = id;
+		cfg["level"] = level;
+		cfg["hitpoints"] = 30 + level * 10;
+		cfg["random_traits"] = false;
+		cfg["animate"] = false;
+
+		auto type = std::make_unique<unit_type>(cfg);
+		unit_types.build_unit_type(*type, unit_type::FULL);
+		return type;
+	};
+
+	static const std::unique_ptr<unit_type> grunt = make_type("Orcish Grunt", 1);
+	static const std::unique_ptr<unit_type> warrior = make_type("Orcish Warrior", 2);
+
+	std::vector<map_location> hexes;
+	for(int x = 0; x < map_size; ++x) {
+		for(int y = 0; y < map_size; ++y) {
+			hexes.emplace_back(x, y);
+		}
+	}
+
+	std::mt19937 rng(benchmark::default_seed);
+	std::shuffle(hexes.begin(), hexes.end(), rng);
+
+	for(std::size_t i = 0; i < count; ++i) {
+		const unit_type& type = i % 3 == 0 ? *warrior : *grunt;
+		board.units().add(hexes[i], *unit::create(type, static_cast<int>(i % 4) + 1, false));
+	}
+}
+
+const benchmark::registration terrain_filter_match("filter/terrain_match", [] {
+	const auto ctx = std::make_shared<board_filter_context>(synthetic_level());
+
+	config cfg;
+	cfg["x"] = "2-60";
+	cfg["y"] = "4-62";
+	config& adjacent = cfg.add_child("filter_adjacent_location");
+	adjacent["adjacent"] = "n,ne,se,s";
+	adjacent["count"] = "1-3";
+	adjacent["x"] = "1-40";
+	cfg.add_child("not")["x"] = "20-30";
+
+	const auto filter = std::make_shared<const terrain_filter>(vconfig(cfg, true), ctx.get(), false);
+
+	return [ctx, filter] {
+		int matches = 0;
+		for(int x = 0; x < map_size; ++x) {
+			for(int y = 0; y < map_size; ++y) {
+				matches += filter->match(map_location(x, y));
+			}
+		}
+
+		benchmark::do_not_optimize(matches);
+	};
+});
+
+const benchmark::registration terrain_filter_radius("filter/terrain_get_locations_radius", [] {
+	const auto ctx = std::make_shared<board_filter_context>(synthetic_level());
+
+	config cfg;
+	cfg["x"] = "8,24,40,56";
+	cfg["y"] = "8,24,40,56";
+	cfg["radius"] = 3;
+	config& restrict = cfg.add_child("filter_radius");
+	restrict.add_child("not")["x"] = "30-34";
+
+	const auto filter = std::make_shared<const terrain_filter>(vconfig(cfg, true), ctx.get(), false);
+
+	return [ctx, filter] {
+		std::set<map_location> locs;
+		filter->get_locations(locs);
+		benchmark::do_not_optimize(locs);
+	};
+});
+
+/** Matches every unit of a board with 400 units against @a filter_cfg. */
+benchmark::setup_function unit_filter_benchmark(const config& filter_cfg)
+{
+	return [filter_cfg] {
+		const auto ctx = std::make_shared<board_filter_context>(synthetic_level());
+		place_units(ctx->board, 400);
+
+		const auto filter = std::make_shared<const unit_filter>(vconfig(filter_cfg, true));
+
+		return [ctx, filter] {
+			int matches = 0;
+			for(const unit& u : ctx->board.units()) {
+				matches += filter->matches(u);
+			}
+
+			benchmark::do_not_optimize(matches);
+		};
+	};
+}
+
+config simple_unit_filter()
+{
+	config cfg;
+	cfg["side"] = "1,3";
+	cfg["type"] = "Orcish Grunt";
+	cfg["level"] = "1-2";
+	return cfg;
+}
+
+config adjacent_unit_filter()
+{
+	config cfg;
+	cfg["side"] = "1,2,3";
+	cfg.add_child("filter_location")["x"] = "1-48";
+
+	config& adjacent = cfg.add_child("filter_adjacent");
+	adjacent["side"] = "2,4";
+	adjacent["count"] = "1-6";
+
+	return cfg;
+}
+
+const benchmark::registration unit_filter_simple("filter/unit_simple", unit_filter_benchmark(simple_unit_filter()));
+const benchmark::registration unit_filter_adjacent("filter/unit_adjacent", unit_filter_benchmark(adjacent_unit_filter()));
+} // anonymous namespace
@@ -0,0 +1,82 @@
+/*
+	Copyright (C) 2024 - 2024
+	by the Battle for Wesnoth developers
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#include "benchmarks/benchmark.hpp"
+
+#include "formula/callable.hpp"
+#include "formula/formula.hpp"
+
+#include <memory>
+#include <vector>
+
+using namespace wfl;
+
+namespace
+{
+/** List processing, as in the candidate action evaluations of formula AIs. */
+const std::string list_formula
+	= "sum(map(1 ~ 300, x * x + x / 2)) + size(filter(1 ~ 300, x % 3 = 0)) + max(sort(map(1 ~ 50, (x * 37) % 11), a > b))";
+
+/** Lookups of a unit like callable, as in [filter] formula= keys and ability values. */
+const std::string unit_formula
+	= "if(hitpoints < max_hitpoints / 2, max_hitpoints - hitpoints, 0) + max(map(attacks, damage * number)) * level"
+	  " + size(filter(traits, self = 'quick' or self = 'strong'))";
+
+std::shared_ptr<map_formula_callable> unit_callable()
+{
+	auto unit = std::make_shared<map_formula_callable>();
+	unit->add("hitpoints", variant(17));
+	unit->add("max_hitpoints", variant(42));
+	unit->add("level", variant(2));
+
+	std::vector<variant> attacks;
+	for(int i = 0; i < 3; ++i) {
+		auto attack = std::make_shared<map_formula_callable>();
+		attack->add("damage", variant(5 + i * 3));
+		attack->add("number", variant(4 - i));
+		attacks.emplace_back(attack);
+	}
+	unit->add("attacks", variant(attacks));
+
+	std::vector<variant> traits {variant("quick"), variant("resilient"), variant("strong")};
+	unit->add("traits", variant(traits));
+
+	return unit;
+}
+
+const benchmark::registration formula_parse("formula/parse", [] {
+	return [] {
+		formula f(unit_formula);
+		benchmark::do_not_optimize(f);
+	};
+});
+
+const benchmark::registration formula_list("formula/evaluate_lists", [] {
+	const auto f = std::make_shared<const formula>(list_formula);
+	return [f] {
+		const variant result = f->evaluate();
+		benchmark::do_not_optimize(result);
+	};
+});
+
+const benchmark::registration formula_unit("formula/evaluate_unit", [] {
+	const auto f = std::make_shared<const formula>(unit_formula);
+	const auto unit = unit_callable();
+	return [f, unit] {
+		const variant result = f->evaluate(*unit);
+		benchmark::do_not_optimize(result);
+	};
+});
+} // anonymous namespace
@@ -0,0 +1,125 @@
+/*
+	Copyright (C) 2024 - 2024
+	by the Battle for Wesnoth developers
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#include "benchmarks/benchmark.hpp"
+#include "benchmarks/synthetic.hpp"
+
+#include "color.hpp"
+#include "config.hpp"
+#include "game_config.hpp"
+#include "game_config_view.hpp"
+#include "image_modifications.hpp"
+#include "sdl/surface.hpp"
+#include "serialization/string_utils.hpp"
+
+#include <random>
+
+namespace
+{
+/** The mainline team color source palette. */
+const std::string magenta_palette
+	= "F49AC1,3F0016,55002A,690039,7B0045,8C0051,9E005D,B10069,C30074,D6007F,EC008C,EE3D96,EF5BA1,F172AC,F287B6";
+
+/** Registers the palette and color ranges used by the ~RC() modifications. */
+void set_up_color_info()
+{
+	static bool done = false;
+	if(done) {
+		return;
+	}
+
+	config cfg;
+	config& red = cfg.add_child("color_range");
+	red["id"] = "red";
+	red["rgb"] = "FF0000,FFFFFF,000000,FF0000";
+
+	config& blue = cfg.add_child("color_range");
+	blue["id"] = "blue";
+	blue["rgb"] = "2E419B,FFFFFF,0F0F0F,0000FF";
+
+	cfg.add_child("color_palette")["magenta"] = magenta_palette;
+
+	game_config::add_color_info(game_config_view::wrap(cfg));
+	done = true;
+}
+
+/**
+ * A @a size x @a size sprite: a disc of team color pixels with random shading
+ * on a transparent background, like a unit image.
+ */
+surface synthetic_sprite(int size)
+{
+	std::vector<color_t> colors;
+	for(const std::string& hex : utils::split(magenta_palette)) {
+		colors.push_back(color_t::from_hex_string(hex));
+	}
+
+	std::mt19937 rng(benchmark::default_seed);
+	std::uniform_int_distribution<int> pick(0, static_cast<int>(colors.size()) * 3 - 1);
+	std::uniform_int_distribution<int> shade(0, 255);
+
+	surface surf(size, size);
+	surface_lock lock(surf);
+	uint32_t* pixels = lock.pixels();
+
+	const int center = size / 2;
+	for(int y = 0; y < size; ++y) {
+		for(int x = 0; x < size; ++x) {
+			color_t c(0, 0, 0, 0);
+			if((x - center) * (x - center) + (y - center) * (y - center) < center * center) {
+				const int i = pick(rng);
+				c = i < static_cast<int>(colors.size())
+					? colors[i]
+					: color_t(shade(rng), shade(rng), shade(rng), 255);
+			}
+
+			pixels[y * size + x] = c.to_argb_bytes();
+		}
+	}
+
+	return surf;
+}
+
+/** Decodes @a mods and applies them to a copy of a synthetic sprite, as image::locator does for a file. */
+benchmark::setup_function chain(const std::string& mods, int size = 72)
+{
+	return [mods, size] {
+		set_up_color_info();
+		const surface sprite = synthetic_sprite(size);
+
+		return [mods, sprite] {
+			surface surf = sprite.clone();
+			image::modification_queue queue = image::modification::decode(mods);
+			while(!queue.empty()) {
+				surf = (*queue.top())(surf);
+				queue.pop();
+			}
+
+			benchmark::do_not_optimize(surf);
+		};
+	};
+}
+
+const benchmark::registration image_team_color("image/team_color", chain("~RC(magenta>red)"));
+
+const benchmark::registration image_unit_chain(
+	"image/unit_chain", chain("~RC(magenta>blue)~FL(horiz)~CS(10,-20,30)~O(0.8)~BLEND(0,0,255,0.25)~GS()"));
+
+const benchmark::registration image_scale_chain(
+	"image/scale_chain", chain("~SCALE(144,144)~ROTATE(90)~CROP(18,18,108,108)~SCALE_INTO_SHARP(72,72)"));
+
+const benchmark::registration image_large_chain(
+	"image/large_chain", chain("~RC(magenta>red)~FL()~O(0.5)~GS()", 512));
+} // anonymous namespace
@@ -0,0 +1,183 @@
+/*
+	Copyright (C) 2024 - 2024
+	by the Battle for Wesnoth developers
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+/**
+ * @file
+ * Entry point of the wesnoth_benchmarks program.
+ *
+ * Runs the registered benchmarks and writes their results as JSON or CSV, so
+ * that a build pipeline can compare them against a previous run. Like the unit
+ * tests, it expects to be started from the root of the source tree.
+ */
+
+#include "benchmarks/benchmark.hpp"
+
+#include "commandline_argv.hpp"
+#include "filesystem.hpp"
+#include "game_config.hpp"
+#include "log.hpp"
+
+#include <boost/program_options/options_description.hpp>
+#include <boost/program_options/parsers.hpp>
+#include <boost/program_options/variables_map.hpp>
+
+#include <iostream>
+#include <ostream>
+
+namespace po = boost::program_options;
+
+namespace
+{
+bool selected(const std::string& name, const std::vector<std::string>& filters)
+{
+	if(filters.empty()) {
+		return true;
+	}
+
+	return std::any_of(filters.begin(), filters.end(),
+		[&name](const std::string& filter) { return name.find(filter) != std::string::npos; });
+}
+
+void write_json(std::ostream& out, const std::vector<benchmark::result>& results)
+{
+	out << "{\"benchmarks\":[";
+	for(std::size_t i = 0; i < results.size(); ++i) {
+		const benchmark::result& r = results[i];
+
+		out << (i == 0 ? "\n" : ",\n")
+			<< "{\"name\":\"" << r.name
+			<< "\",\"calls_per_sample\":" << r.calls_per_sample
+			<< ",\"median_ns\":" << r.median().count()
+			<< ",\"min_ns\":" << r.min().count()
+			<< ",\"max_ns\":" << r.max().count()
+			<< ",\"samples_ns\":[";
+
+		for(std::size_t s = 0; s < r.samples.size(); ++s) {
+			out << (s == 0 ? "" : ",") << r.samples[s].count();
+		}
+		out << "]}";
+	}
+	out << "\n]}\n";
+}
+
+void write_csv(std::ostream& out, const std::vector<benchmark::result>& results)
+{
+	out << "name,calls_per_sample,samples,median_ns,min_ns,max_ns\n";
+	for(const benchmark::result& r : results) {
+		out << r.name << ',' << r.calls_per_sample << ',' << r.samples.size() << ',' << r.median().count() << ','
+			<< r.min().count() << ',' << r.max().count() << '\n';
+	}
+}
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+	po::options_description opts{"Allowed options"};
+	opts.add_options()
+		("help,h", "prints this message and exits.")
+		("list", "lists the available benchmarks and exits.")
+		("filter", po::value<std::vector<std::string>>()->composing(),
+			"only runs the benchmarks whose name contains <arg>. Can be given several times.")
+		("format", po::value<std::string>()->default_value("json"), "output format, either json or csv.")
+		("output,o", po::value<std::string>(), "writes the results to <arg> instead of the standard output.")
+		("samples", po::value<unsigned>()->default_value(10), "number of samples taken of each benchmark.")
+		("sample-time", po::value<unsigned>()->default_value(50), "approximate duration of a sample, in milliseconds.")
+		("data-dir", po::value<std::string>(), "root of the source tree holding the data directory. Defaults to the working directory.")
+		;
+
+	po::variables_map vm;
+	try {
+		const std::vector<std::string> args = read_argv(argc, argv);
+		po::store(po::command_line_parser(std::vector<std::string>(args.begin() + 1, args.end())).options(opts).run(), vm);
+		po::notify(vm);
+	} catch(const po::error& e) {
+		PLAIN_LOG << e.what() << "\n\n" << opts;
+		return 2;
+	}
+
+	if(vm.count("help")) {
+		std::cout << "Usage: " << argv[0] << " [options]\n\n" << opts;
+		return 0;
+	}
+
+	// Registration order depends on the link order, so sort to keep the output stable.
+	std::vector<benchmark::entry>& entries = benchmark::registry();
+	std::sort(entries.begin(), entries.end(),
+		[](const benchmark::entry& a, const benchmark::entry& b) { return a.name < b.name; });
+
+	if(vm.count("list")) {
+		for(const benchmark::entry& e : entries) {
+			std::cout << e.name << '\n';
+		}
+
+		return 0;
+	}
+
+	const std::string format = vm["format"].as<std::string>();
+	if(format != "json" && format != "csv") {
+		PLAIN_LOG << "unknown output format '" << format << "', expected json or csv";
+		return 2;
+	}
+
+	std::vector<std::string> filters;
+	if(vm.count("filter")) {
+		filters = vm["filter"].as<std::vector<std::string>>();
+	}
+
+	benchmark::options bench_opts;
+	bench_opts.samples = vm["samples"].as<unsigned>();
+	bench_opts.sample_time = std::chrono::milliseconds(vm["sample-time"].as<unsigned>());
+
+	game_config::path = vm.count("data-dir") ? vm["data-dir"].as<std::string>() : filesystem::get_cwd();
+
+	// Loading the test config is noisy, and would make the results harder to read.
+	lg::set_log_domain_severity("all", lg::err());
+
+	std::vector<benchmark::result> results;
+	bool failed = false;
+
+	for(const benchmark::entry& e : entries) {
+		if(!selected(e.name, filters)) {
+			continue;
+		}
+
+		PLAIN_LOG << "running " << e.name;
+		try {
+			results.push_back(benchmark::measure(e, bench_opts));
+		} catch(const std::exception& ex) {
+			PLAIN_LOG << "benchmark " << e.name << " failed: " << ex.what();
+			failed = true;
+		}
+	}
+
+	try {
+		filesystem::scoped_ostream file;
+		if(vm.count("output")) {
+			file = filesystem::ostream_file(vm["output"].as<std::string>());
+		}
+
+		std::ostream& out = file ? *file : std::cout;
+		if(format == "csv") {
+			write_csv(out, results);
+		} else {
+			write_json(out, results);
+		}
+	} catch(const filesystem::io_exception& e) {
+		PLAIN_LOG << "could not write the results: " << e.what();
+		return 1;
+	}
+
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,110 @@
+/*
+	Copyright (C) 2024 - 2024
+	by the Battle for Wesnoth developers
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#include "benchmarks/benchmark.hpp"
+#include "benchmarks/synthetic.hpp"
+
+#include "map/map.hpp"
+#include "pathfind/pathfind.hpp"
+#include "terrain/translation.hpp"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace
+{
+/**
+ * Movement costs by terrain code, roughly those of a foot unit.
+ *
+ * pathfind::paths and shortest_path_calculator need unit types, teams and the
+ * terrain types of a full game config, so the route benchmarks use this
+ * calculator over the raw terrain codes instead. That still exercises all of
+ * a_star_search.
+ */
+class terrain_cost_calculator : public pathfind::cost_calculator
+{
+public:
+	explicit terrain_cost_calculator(const gamemap& map)
+		: map_(map)
+		, costs_()
+	{
+		costs_[t_translation::read_terrain_code("Hh")] = 2;
+		costs_[t_translation::read_terrain_code("Hh^Fp")] = 2;
+		costs_[t_translation::read_terrain_code("Gs^Fp")] = 2;
+		costs_[t_translation::read_terrain_code("Mm")] = 3;
+		costs_[t_translation::read_terrain_code("Ww")] = 3;
+		costs_[t_translation::read_terrain_code("Dd")] = 2;
+		costs_[t_translation::read_terrain_code("Wo")] = getNoPathValue();
+		costs_[t_translation::read_terrain_code("Xu")] = getNoPathValue();
+	}
+
+	double cost(const map_location& loc, const double /*so_far*/) const override
+	{
+		const auto i = costs_.find(map_.get_terrain(loc));
+		return i == costs_.end() ? 1 : i->second;
+	}
+
+private:
+	const gamemap& map_;
+	std::map<t_translation::terrain_code, double> costs_;
+};
+
+struct route_fixture
+{
+	explicit route_fixture(int size)
+		: map(benchmark::synthetic_map_data(size, size))
+		, calc(map)
+	{
+	}
+
+	gamemap map;
+	terrain_cost_calculator calc;
+};
+
+/** Routes between the corners and across the middle of a @a size x @a size map. */
+benchmark::setup_function routes(int size)
+{
+	return [size] {
+		const auto f = std::make_shared<const route_fixture>(size);
+		const int last = size - 1;
+		const std::vector<std::pair<map_location, map_location>> trips {
+			{{0, 0}, {last, last}},
+			{{last, 0}, {0, last}},
+			{{0, size / 2}, {last, size / 2}},
+			{{size / 2, 0}, {size / 3, last}},
+		};
+
+		return [f, trips] {
+			for(const auto& [src, dst] : trips) {
+				const pathfind::plain_route route
+					= pathfind::a_star_search(src, dst, 10000.0, f->calc, f->map.w(), f->map.h());
+				benchmark::do_not_optimize(route);
+			}
+		};
+	};
+}
+
+const benchmark::registration a_star_small("pathfind/a_star_40x40", routes(40));
+const benchmark::registration a_star_large("pathfind/a_star_200x200", routes(200));
+
+const benchmark::registration map_read("map/read_200x200", [] {
+	const auto data = std::make_shared<const std::string>(benchmark::synthetic_map_data(200, 200));
+	return [data] {
+		gamemap map(*data);
+		benchmark::do_not_optimize(map);
+	};
+});
+} // anonymous namespace
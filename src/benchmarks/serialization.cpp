@@ -0,0 +1,111 @@
+/*
+	Copyright (C) 2024 - 2024
+	by the Battle for Wesnoth developers
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#include "benchmarks/benchmark.hpp"
+#include "benchmarks/synthetic.hpp"
+
+#include "config.hpp"
+#include "filesystem.hpp"
+#include "game_config.hpp"
+#include "serialization/parser.hpp"
+#include "serialization/preprocessor.hpp"
+#include "server/common/simple_wml.hpp"
+
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+/** Number of units in the synthetic saved game, about 1.5 MB of WML. */
+constexpr std::size_t num_units = 4000;
+
+std::shared_ptr<const std::string> synthetic_wml()
+{
+	std::ostringstream out;
+	write(out, benchmark::synthetic_units_config(num_units));
+	return std::make_shared<const std::string>(out.str());
+}
+
+const benchmark::registration config_parse("config/parse", [] {
+	const auto text = synthetic_wml();
+	return [text] {
+		config cfg;
+		read(cfg, *text);
+		benchmark::do_not_optimize(cfg);
+	};
+});
+
+const benchmark::registration config_write("config/write", [] {
+	const auto cfg = std::make_shared<const config>(benchmark::synthetic_units_config(num_units));
+	return [cfg] {
+		std::ostringstream out;
+		write(out, *cfg);
+		benchmark::do_not_optimize(out);
+	};
+});
+
+const benchmark::registration config_copy("config/copy", [] {
+	const auto cfg = std::make_shared<const config>(benchmark::synthetic_units_config(num_units));
+	return [cfg] {
+		config copy = *cfg;
+		benchmark::do_not_optimize(copy);
+	};
+});
+
+/** Preprocesses the mainline macro directory, which every game config load starts with. */
+const benchmark::registration preprocessor_core_macros("preprocessor/core_macros", [] {
+	const std::string path = game_config::path + "/data/core/macros/";
+	if(!filesystem::is_directory(path)) {
+		throw std::runtime_error("cannot find " + path + ", run from the root of the source tree or use --data-dir");
+	}
+
+	return [path] {
+		preproc_map defines;
+		filesystem::scoped_istream stream = preprocess_file(path, &defines);
+		const std::string output{std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>()};
+		benchmark::do_not_optimize(output);
+	};
+});
+
+const benchmark::registration simple_wml_parse("simple_wml/parse", [] {
+	const auto text = synthetic_wml();
+	return [text] {
+		simple_wml::document doc(text->c_str(), simple_wml::INIT_STATIC);
+		benchmark::do_not_optimize(doc);
+	};
+});
+
+const benchmark::registration simple_wml_compress("simple_wml/compress", [] {
+	const auto text = synthetic_wml();
+	return [text] {
+		simple_wml::document doc(text->c_str(), simple_wml::INIT_COMPRESSED);
+		benchmark::do_not_optimize(doc);
+	};
+});
+
+const benchmark::registration simple_wml_decompress("simple_wml/decompress", [] {
+	const auto text = synthetic_wml();
+	simple_wml::document doc(text->c_str(), simple_wml::INIT_COMPRESSED);
+	const simple_wml::string_span compressed = doc.output_compressed();
+	const auto data = std::make_shared<const std::string>(compressed.begin(), compressed.end());
+
+	return [data] {
+		simple_wml::document doc(simple_wml::string_span(data->data(), static_cast<int>(data->size())));
+		benchmark::do_not_optimize(doc);
+	};
+});
+} // anonymous namespace
@@ -0,0 +1,113 @@
+/*
+	Copyright (C) 2024 - 2024
+	by the Battle for Wesnoth developers
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#pragma once
+
+#include "config.hpp"
+#include "tstring.hpp"
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <string>
+
+/**
+ * Synthetic benchmark inputs.
+ *
+ * Everything is generated from a fixed seed, so the same build always
+ * benchmarks the same maps and WML.
+ */
+namespace benchmark
+{
+constexpr std::uint32_t default_seed = 0x5745534e; // "WESN"
+
+/**
+ * A random map of @a w x @a h hexes, plus a one hex border, in the format of
+ * the map_data attribute. It mixes the common base terrains with forest and
+ * village overlays, and some impassable hexes to make routes less direct.
+ */
+inline std::string synthetic_map_data(int w, int h, std::uint32_t seed = default_seed)
+{
+	static const std::array<const char*, 12> terrains {
+		"Gg", "Gg", "Gs", "Gs^Fp", "Hh", "Hh^Fp", "Mm", "Ww", "Wo", "Re", "Dd", "Gg^Vh",
+	};
+
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<std::size_t> pick(0, terrains.size() - 1);
+	std::uniform_int_distribution<int> percent(0, 99);
+
+	std::string data;
+	for(int y = 0; y < h + 2; ++y) {
+		for(int x = 0; x < w + 2; ++x) {
+			data += x == 0 ? "" : ", ";
+			data += percent(rng) < 3 ? "Xu" : terrains[pick(rng)];
+		}
+		data += '\n';
+	}
+
+	return data;
+}
+
+/**
+ * A saved game like config with @a count units, each with traits, effects,
+ * attacks and some variables, shaped after the [unit]s of real saves.
+ */
+inline config synthetic_units_config(std::size_t count, std::uint32_t seed = default_seed)
+{
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<int> coord(1, 64);
+	std::uniform_int_distribution<int> stat(1, 60);
+
+	config cfg;
+	for(std::size_t i = 0; i < count; ++i) {
+		config& unit = cfg.add_child("unit");
+		unit["id"] = "Unit-" + std::to_string(i);
+		unit["type"] = i % 2 == 0 ? "Elvish Fighter" : "Orcish Grunt";
+		unit["side"] = static_cast<int>(i % 4) + 1;
+		unit["x"] = coord(rng);
+		unit["y"] = coord(rng);
+		unit["hitpoints"] = stat(rng);
+		unit["experience"] = stat(rng);
+		unit["moves"] = 5;
+		unit["facing"] = "se";
+		unit["name"] = t_string("Name " + std::to_string(i), "wesnoth-units");
+
+		config& mods = unit.add_child("modifications");
+		for(const char* trait : {"strong", "quick"}) {
+			config& t = mods.add_child("trait");
+			t["id"] = trait;
+			t["male_name"] = t_string(trait, "wesnoth");
+
+			config& effect = t.add_child("effect");
+			effect["apply_to"] = "hitpoints";
+			effect["increase_total"] = stat(rng) % 5;
+		}
+
+		config& attack = unit.add_child("attack");
+		attack["name"] = "sword";
+		attack["type"] = "blade";
+		attack["range"] = "melee";
+		attack["damage"] = stat(rng) % 12 + 2;
+		attack["number"] = stat(rng) % 4 + 1;
+
+		config& vars = unit.add_child("variables");
+		vars["kills"] = stat(rng);
+		vars["note"] = "Lorem ipsum dolor sit amet, consectetur adipiscing elit";
+	}
+
+	return cfg;
+}
+
+} // namespace benchmark
@@ -0,0 +1,51 @@
+/*
+	Copyright (C) 2024 - 2024
+	by the Battle for Wesnoth developers
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#include "benchmarks/benchmark.hpp"
+#include "benchmarks/synthetic.hpp"
+
+#include "config.hpp"
+#include "game_config_view.hpp"
+#include "map/map.hpp"
+#include "picture.hpp"
+#include "terrain/builder.hpp"
+#include "tests/utils/game_config_manager_tests.hpp"
+
+#include <memory>
+
+namespace
+{
+/**
+ * Builds the terrain graphics of a synthetic map with the [terrain_graphics]
+ * rules of the test config, as every scenario start does. The global rules are
+ * parsed during the warm-up call, so this times building with cached rules.
+ */
+benchmark::setup_function build(int size)
+{
+	return [size] {
+		static const game_config_view rules = game_config_view::wrap(test_utils::get_test_config_ref());
+		terrain_builder::set_terrain_rules_cfg(rules);
+
+		const auto map = std::make_shared<const gamemap>(benchmark::synthetic_map_data(size, size));
+		return [map] {
+			terrain_builder builder(config(), map.get(), "off-map/alpha", true);
+			benchmark::do_not_optimize(builder);
+		};
+	};
+}
+
+const benchmark::registration builder_small("terrain_builder/build_32x32", build(32));
+const benchmark::registration builder_large("terrain_builder/build_96x96", build(96));
+} // anonymous namespace
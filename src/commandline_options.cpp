@@ -126,6 +126,8 @@ commandline_options::commandline_options(const std::vector<std::string>& args)
 	, server()
 	, username()
 	, password()
+	, profile_load_format()
+	, profile_load_file()
 	, render_image()
 	, render_image_dst()
 	, screenshot(false)
@@ -138,6 +140,7 @@ commandline_options::commandline_options(const std::vector<std::string>& args)
 	, test()
 	, unit_test()
 	, headless_unit_test(false)
+	, unit_test_report()
 	, noreplaycheck(false)
 	, mptest(false)
 	, usercache_path(false)
@@ -202,6 +205,7 @@ commandline_options::commandline_options(const std::vector<std::string>& args)
 		("nosound", "runs the game without sounds and music.")
 		("password", po::value<std::string>(), "uses <password> when connecting to a server, ignoring other preferences.")
 		("plugin", po::value<std::string>(), "(experimental) load a script which defines a wesnoth plugin. similar to --script below, but Lua file should return a function which will be run as a coroutine and periodically woken up with updates.")
+		("profile-load", po::value<two_strings>()->multitoken(), "takes two arguments: <format> <output>. Writes the time spent in each phase of every scenario load to <output>, after each load. <format> is either 'json' for a timing tree or 'chrome' for a Chrome trace.")
 		("render-image", po::value<two_strings>()->multitoken(), "takes two arguments: <image> <output>. Like screenshot, but instead of a map, takes a valid Wesnoth 'image path string' with image path functions, and writes it to a .png file." IMPLY_TERMINAL)
 		("report,R", "initializes game directories, prints build information suitable for use in bug reports, and exits." IMPLY_TERMINAL)
 		("rng-seed", po::value<unsigned int>(), "seeds the random number generator with number <arg>. Example: --rng-seed 0")
@@ -278,6 +282,7 @@ commandline_options::commandline_options(const std::vector<std::string>& args)
 	testing_opts.add_options()
 		("test,t", po::value<std::string>()->implicit_value(std::string()), "runs the game in a small test scenario. If specified, scenario <arg> will be used instead.")
 		("unit,u", po::value<std::vector<std::string>>(), "runs a unit test scenario. The GUI is not shown and the exit code of the program reflects the victory / defeat conditions of the scenario.\n\t0 - PASS\n\t1 - FAIL\n\t3 - FAIL (INVALID REPLAY)\n\t4 - FAIL (ERRORED REPLAY)\n\t5 - FAIL (BROKE STRICT)\n\t6 - FAIL (WML EXCEPTION)\n\tMultiple tests can be run by giving this option multiple times, in this case the test run will stop immediately after any test which doesn't PASS and the return code will be the status of the test that caused the stop." IMPLY_TERMINAL)
+		("unit-report", po::value<std::string>(), "runs every unit test scenario given with --unit, even after one fails, and writes a line with the status, duration in seconds and name of each test to the specified file as soon as it finishes. The exit code is the status of the first test which didn't PASS.")
 		("showgui", "don't run headlessly (for debugging a failing test)")
 		("log-strict", po::value<std::string>(), "sets the strict level of the logger. any messages sent to log domains of this level or more severe will cause the unit test to fail regardless of the victory result.")
 		("nobanner", "suppress startup banner.")
@@ -460,6 +465,14 @@ commandline_options::commandline_options(const std::vector<std::string>& args)
 		rng_seed = vm["rng-seed"].as<unsigned int>();
 	if(vm.count("scenario"))
 		multiplayer_scenario = vm["scenario"].as<std::string>();
+	if(vm.count("profile-load"))
+	{
+		profile_load_format = vm["profile-load"].as<two_strings>().first;
+		profile_load_file = vm["profile-load"].as<two_strings>().second;
+		if(*profile_load_format != "json" && *profile_load_format != "chrome") {
+			throw po::validation_error(po::validation_error::invalid_option_value, "profile-load", *profile_load_format);
+		}
+	}
 	if(vm.count("render-image"))
 	{
 		render_image = vm["render-image"].as<two_strings>().first;
@@ -494,6 +507,8 @@ commandline_options::commandline_options(const std::vector<std::string>& args)
 		unit_test = vm["unit"].as<std::vector<std::string>>();
 		headless_unit_test = true;
 	}
+	if(vm.count("unit-report"))
+		unit_test_report = vm["unit-report"].as<std::string>();
 	if(vm.count("showgui"))
 		headless_unit_test = false;
 	if(vm.count("noreplaycheck"))
@@ -184,6 +184,10 @@ public:
 	std::optional<std::string> username;
 	/** Non-empty if --password was given on the command line. Forces Wesnoth to use this network password. */
 	std::optional<std::string> password;
+	/** Output format given to the --profile-load option, either "json" or "chrome". */
+	std::optional<std::string> profile_load_format;
+	/** Output file given to the --profile-load option. */
+	std::optional<std::string> profile_load_file;
 	/** Image path to render. First parameter after --render-image */
 	std::optional<std::string> render_image;
 	/** Output file to put rendered image path in. Optional second parameter after --render-image */
@@ -208,6 +212,8 @@ public:
 	std::vector<std::string> unit_test;
 	/** True if --unit is used and --showgui is not present. */
 	bool headless_unit_test;
+	/** Non-empty if --unit-report was given on the command line. Every unit test is run and its result written to this file. Dependent on --unit. */
+	std::optional<std::string> unit_test_report;
 	/** True if --noreplaycheck was given on the command line. Dependent on --unit. */
 	bool noreplaycheck;
 	/** True if --mp-test was given on the command line. */
@@ -28,6 +28,7 @@
 #include "filesystem.hpp"
 #include "font/sdl_ttf_compat.hpp"
 #include "font/text.hpp"
+#include "frame_profiler.hpp"
 #include "preferences/game.hpp"
 #include "halo.hpp"
 #include "hotkey/command_executor.hpp"
@@ -165,6 +166,7 @@ display::display(const display_context* dc,
 	, invalidateAll_(true)
 	, diagnostic_label_(0)
 	, invalidateGameStatus_(true)
+	, invalidatedReportDependencies_(reports::DEP_ALL)
 	, map_labels_(new map_labels(nullptr))
 	, reports_object_(&reports_object)
 	, scroll_event_("scrolled")
@@ -336,18 +338,16 @@ texture display::get_flag(const map_location& loc)
 		return texture();
 	}
 
-	for (const team& t : dc_->teams()) {
-		if (t.owns_village(loc) && (!fogged(loc) || !dc_->get_team(viewing_side()).is_enemy(t.side())))
-		{
-			auto& flag = flags_[t.side() - 1];
-			flag.update_last_draw_time();
-			const image::locator &image_flag = animate_map_ ?
-				flag.get_current_frame() : flag.get_first_frame();
-			return image::get_texture(image_flag, image::TOD_COLORED);
-		}
+	const int owner = dc_->village_owner(loc);
+	if (owner == 0 || (fogged(loc) && dc_->get_team(viewing_side()).is_enemy(owner))) {
+		return texture();
 	}
 
-	return texture();
+	auto& flag = flags_[owner - 1];
+	flag.update_last_draw_time();
+	const image::locator &image_flag = animate_map_ ?
+		flag.get_current_frame() : flag.get_first_frame();
+	return image::get_texture(image_flag, image::TOD_COLORED);
 }
 
 void display::set_team(std::size_t teamindex, bool show_everything)
@@ -1304,6 +1304,8 @@ void display::drawing_buffer_add(const drawing_layer layer, const map_location&
 
 void display::drawing_buffer_commit()
 {
+	const frame_profiler::scope profiler_scope(frame_profiler::section::drawing_buffer_commit);
+
 	DBG_DP << "committing drawing buffer"
 	       << " with " << drawing_buffer_.size() << " items";
 
@@ -1324,8 +1326,19 @@ void display::drawing_buffer_commit()
 	 * This ended in the following priority order:
 	 * layergroup > location > layer > 'draw_helper' > surface
 	 */
-	for(const draw_helper& helper : drawing_buffer_) {
-		std::invoke(helper.do_draw, helper.dest);
+	if(frame_profiler::enabled()) {
+		// Also attribute the time to the layer each entry is drawn on.
+		constexpr uint32_t layer_mask = (1u << BITS_FOR_LAYER) - 1;
+		for(const draw_helper& helper : drawing_buffer_) {
+			const auto start = frame_profiler::clock::now();
+			std::invoke(helper.do_draw, helper.dest);
+			frame_profiler::record_layer((helper.key >> SHIFT_LAYER) & layer_mask,
+				std::chrono::duration_cast<frame_profiler::microseconds>(frame_profiler::clock::now() - start));
+		}
+	} else {
+		for(const draw_helper& helper : drawing_buffer_) {
+			std::invoke(helper.do_draw, helper.dest);
+		}
 	}
 
 	drawing_buffer_.clear();
@@ -1376,6 +1389,64 @@ void display::update_fps_label()
 		stream << "\nhex: " << drawn_hexes_*1.0/sample_freq;
 		if (drawn_hexes_ != invalidated_hexes_)
 			stream << " (" << (invalidated_hexes_-drawn_hexes_)*1.0/sample_freq << ")";
+
+		const draw_manager::frame_timings& frame = draw_manager::last_frame_timings();
+		stream << "\n<tt>frame: " << frame.update.count() << '/' << frame.layout.count() << '/'
+			<< frame.render.count() << '/' << frame.expose.count() << '/' << frame.present.count()
+			<< " us, between frames " << frame.outside.count() / 1000 << " ms</tt>";
+
+		// The sidebar reports that took longest to generate since the last sample.
+		std::vector<std::pair<std::string, reports::timing>> report_times(
+			reports_object_->timings().begin(), reports_object_->timings().end());
+		std::sort(report_times.begin(), report_times.end(), [](const auto& a, const auto& b) {
+			return a.second.total > b.second.total;
+		});
+		if(report_times.size() > 3) {
+			report_times.resize(3);
+		}
+		for(const auto& [name, timing] : report_times) {
+			stream << "\n<tt>" << name << ": " << timing.calls << "x "
+				<< timing.total.count() << " us (max " << timing.max.count() << " us)</tt>";
+		}
+		reports_object_->reset_timings();
+
+		write_debug_stats(stream);
+	}
+
+	const std::vector<frame_profiler::frame_sample>& profiled_frames = frame_profiler::history();
+	if(frame_profiler::enabled() && !profiled_frames.empty()) {
+		// Average over the frames drawn since the previous sample.
+		const std::size_t num_frames = std::min<std::size_t>(profiled_frames.size(), sample_freq);
+		frame_profiler::frame_sample sum;
+		for(auto it = profiled_frames.end() - num_frames; it != profiled_frames.end(); ++it) {
+			for(std::size_t i = 0; i < frame_profiler::num_sections; ++i) {
+				sum.time[i] += it->time[i];
+				sum.calls[i] += it->calls[i];
+			}
+			if(sum.layers.size() < it->layers.size()) {
+				sum.layers.resize(it->layers.size());
+			}
+			for(std::size_t layer = 0; layer < it->layers.size(); ++layer) {
+				sum.layers[layer] += it->layers[layer];
+			}
+		}
+
+		stream << "\n\n<tt>per frame:     us  calls</tt>";
+		for(std::size_t i = 0; i < frame_profiler::num_sections; ++i) {
+			stream << "\n<tt>" << std::left << std::setw(22) << frame_profiler::section_names[i] << std::right
+				<< std::setw(7) << sum.time[i].count() / num_frames
+				<< std::setw(6) << sum.calls[i] / num_frames << "</tt>";
+		}
+
+		// The drawing layers that took the longest to commit.
+		std::vector<std::size_t> layers(sum.layers.size());
+		std::iota(layers.begin(), layers.end(), 0);
+		std::sort(layers.begin(), layers.end(), [&sum](std::size_t a, std::size_t b) {
+			return sum.layers[a] > sum.layers[b];
+		});
+		for(std::size_t i = 0; i < std::min<std::size_t>(layers.size(), 3); ++i) {
+			stream << "\n<tt>layer " << layers[i] << ": " << sum.layers[layers[i]].count() / num_frames << " us</tt>";
+		}
 	}
 	drawn_hexes_ = 0;
 	invalidated_hexes_ = 0;
@@ -1677,6 +1748,7 @@ void display::redraw_minimap()
 
 void display::draw_minimap()
 {
+	const frame_profiler::scope profiler_scope(frame_profiler::section::minimap);
 	const rect& area = minimap_area();
 
 	if(area.empty() || !area.overlaps(draw::get_clip())) {
@@ -2327,7 +2399,7 @@ void display::queue_rerender()
 	// This is specifically for game_display.
 	// It would probably be better to simply make this function virtual,
 	// if game_display needs to do special processing.
-	invalidateGameStatus_ = true;
+	invalidate_game_status();
 
 	reportLocations_.clear();
 	reportSurfaces_.clear();
@@ -2414,7 +2486,10 @@ void display::draw()
 		drawing_buffer_commit();
 	}
 
-	if(preferences::show_fps() || debug_flag_set(DEBUG_BENCHMARK)) {
+	const bool show_fps = preferences::show_fps() || debug_flag_set(DEBUG_BENCHMARK) || frame_profiler::enabled();
+	// The report timings are only listed by the debug FPS overlay.
+	reports_object_->set_collect_timings(show_fps && game_config::debug);
+	if(show_fps) {
 		update_fps_label();
 		update_fps_count();
 	} else if(fps_handle_ != 0) {
@@ -2515,7 +2590,10 @@ bool display::expose(const rect& region)
 	}
 
 	// Render halos.
-	halo_man_.render(clipped_region);
+	{
+		const frame_profiler::scope profiler_scope(frame_profiler::section::halos);
+		halo_man_.render(clipped_region);
+	}
 
 	// Render UI elements.
 	// Ideally buttons would be drawn as part of panels,
@@ -2529,7 +2607,10 @@ bool display::expose(const rect& region)
 
 	// Floating labels should probably be separated by type,
 	// but they aren't so they all get drawn here.
-	font::draw_floating_labels();
+	{
+		const frame_profiler::scope profiler_scope(frame_profiler::section::floating_labels);
+		font::draw_floating_labels();
+	}
 
 	// If there's a fade, apply it over everything
 	if(fade_color_.a) {
@@ -2629,6 +2710,7 @@ rect display::get_clip_rect() const
 
 void display::draw_invalidated()
 {
+	const frame_profiler::scope profiler_scope(frame_profiler::section::draw_invalidated);
 	//	log_scope("display::draw_invalidated");
 	SDL_Rect clip_rect = get_clip_rect();
 	const auto clipper = draw::reduce_clip(clip_rect);
@@ -2670,6 +2752,7 @@ void display::draw_invalidated()
 
 void display::draw_hex(const map_location& loc)
 {
+	const frame_profiler::scope profiler_scope(frame_profiler::section::draw_hex);
 	const bool on_map = get_map().on_board(loc);
 	const time_of_day& tod = get_time_of_day(loc);
 
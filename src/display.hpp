@@ -37,7 +37,6 @@ class fake_unit_manager;
 class terrain_builder;
 class map_labels;
 class arrow;
-class reports;
 class team;
 struct overlay;
 
@@ -54,6 +53,7 @@ namespace wb {
 #include "halo.hpp"
 #include "picture.hpp" //only needed for enums (!)
 #include "key.hpp"
+#include "reports.hpp"
 #include "time_of_day.hpp"
 #include "sdl/rect.hpp"
 #include "sdl/surface.hpp"
@@ -65,6 +65,7 @@ namespace wb {
 
 #include <bitset>
 #include <functional>
+#include <iosfwd>
 #include <chrono>
 #include <cstdint>
 #include <list>
@@ -304,7 +305,17 @@ public:
 	virtual void highlight_hex(map_location hex);
 
 	/** Function to invalidate the game status displayed on the sidebar. */
-	void invalidate_game_status() { invalidateGameStatus_ = true; }
+	void invalidate_game_status() { invalidate_reports(reports::DEP_ALL); }
+
+	/**
+	 * Invalidates only the sidebar reports depending on the given
+	 * reports::dependency bits.
+	 */
+	void invalidate_reports(unsigned dependencies)
+	{
+		invalidateGameStatus_ = true;
+		invalidatedReportDependencies_ |= dependencies;
+	}
 
 	/** Functions to get the on-screen positions of hexes. */
 	int get_location_x(const map_location& loc) const;
@@ -702,6 +713,12 @@ protected:
 	 */
 	virtual void draw_hex(const map_location& loc);
 
+	/**
+	 * Appends the statistics of derived displays to the debug overlay shown
+	 * with the frame rate. Each line should start with a newline.
+	 */
+	virtual void write_debug_stats(std::ostream& /*out*/) const {}
+
 	enum TERRAIN_TYPE { BACKGROUND, FOREGROUND};
 
 	void get_terrain_images(const map_location &loc,
@@ -743,6 +760,8 @@ protected:
 	bool invalidateAll_;
 	int diagnostic_label_;
 	bool invalidateGameStatus_;
+	/** The reports::dependency bits changed since the reports were last refreshed. */
+	unsigned invalidatedReportDependencies_;
 	const std::unique_ptr<map_labels> map_labels_;
 	reports * reports_object_;
 
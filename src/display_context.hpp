@@ -103,7 +103,7 @@ public:
 	 * Given the location of a village, will return the 1-based number
 	 * of the team that currently owns it, and 0 if it is unowned.
 	 */
-	int village_owner(const map_location & loc) const;
+	virtual int village_owner(const map_location & loc) const;
 
 	// Accessors from unit.cpp
 
@@ -16,11 +16,13 @@
 
 #include "draw.hpp"
 #include "exceptions.hpp"
+#include "frame_profiler.hpp"
 #include "log.hpp"
 #include "gui/core/top_level_drawable.hpp"
 #include "preferences/general.hpp"
 #include "sdl/rect.hpp"
 #include "utils/general.hpp"
+#include "utils/optimer.hpp"
 #include "video.hpp"
 
 #include <SDL2/SDL_timer.h>
@@ -47,6 +49,8 @@ bool drawing_ = false;
 bool tlds_need_tidying_ = false;
 uint32_t last_sparkle_ = 0;
 bool extra_pass_requested_ = false;
+draw_manager::frame_timings last_frame_timings_;
+std::chrono::steady_clock::time_point last_sparkle_end_;
 } // namespace
 
 namespace draw_manager {
@@ -134,6 +138,20 @@ void sparkle()
 		throw game::error("recursive draw");
 	}
 
+	using std::chrono::duration_cast;
+	using std::chrono::microseconds;
+
+	// Measures each phase of the frame in turn.
+	utils::optimer<microseconds> phase_timer;
+	frame_timings timings;
+	if (last_sparkle_end_ != std::chrono::steady_clock::time_point{}) {
+		timings.outside = duration_cast<microseconds>(phase_timer.start() - last_sparkle_end_);
+	}
+	auto end_phase = [&phase_timer](microseconds& phase) {
+		phase += duration_cast<microseconds>(phase_timer.elapsed());
+		phase_timer.reset();
+	};
+
 	// Remove any invalidated TLDs from previous iterations or events.
 	if (tlds_need_tidying_) {
 		tidy_drawables();
@@ -142,28 +160,36 @@ void sparkle()
 
 	// Animate, process, and update state.
 	draw_manager::update();
+	end_phase(timings.update);
 
 	// Ensure layout is up-to-date.
 	draw_manager::layout();
+	end_phase(timings.layout);
 
 	// If we are running headless or executing unit tests, do not render.
 	// There are not currently any tests for actual rendering output.
 	if(video::headless() || video::testing()) {
 		invalidated_regions_.clear();
+		last_frame_timings_ = timings;
+		last_sparkle_end_ = std::chrono::steady_clock::now();
 		return;
 	}
 
 	// Ensure any off-screen render buffers are up-to-date.
 	draw_manager::render();
+	end_phase(timings.render);
 
 	// Draw to the screen.
 	bool drew_something = draw_manager::expose();
+	end_phase(timings.expose);
 
 	// If extra render passes are requested, render and draw again.
 	while (extra_pass_requested_) {
 		extra_pass_requested_ = false;
 		draw_manager::render();
+		end_phase(timings.render);
 		drew_something |= draw_manager::expose();
+		end_phase(timings.expose);
 	}
 
 	if (drew_something) {
@@ -172,8 +198,16 @@ void sparkle()
 	} else {
 		wait_for_vsync();
 	}
+	end_phase(timings.present);
 
 	last_sparkle_ = SDL_GetTicks();
+	last_frame_timings_ = timings;
+	frame_profiler::end_frame();
+	last_sparkle_end_ = phase_timer.start();
+
+	if (timings.outside.count() > 4 * get_frame_length() * 1000) {
+		DBG_DM << "main loop did not draw for " << timings.outside.count() / 1000 << " ms";
+	}
 }
 
 int get_frame_length()
@@ -189,6 +223,16 @@ int get_frame_length()
 	return std::clamp(vsync_delay, preferences::draw_delay(), 1000);
 }
 
+bool frame_due()
+{
+	return SDL_GetTicks() - last_sparkle_ >= static_cast<uint32_t>(get_frame_length());
+}
+
+const frame_timings& last_frame_timings()
+{
+	return last_frame_timings_;
+}
+
 static void wait_for_vsync()
 {
 	int time_to_wait = last_sparkle_ + get_frame_length() - SDL_GetTicks();
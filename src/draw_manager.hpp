@@ -16,6 +16,8 @@
 
 #include "sdl/rect.hpp"
 
+#include <chrono>
+
 namespace gui2 { class top_level_drawable; }
 
 /**
@@ -123,6 +125,38 @@ void sparkle();
  */
 int get_frame_length();
 
+/**
+ * Whether a new frame should be drawn by now.
+ *
+ * This is true once at least one frame length has passed since the last
+ * call to sparkle(). Long-running work on the main thread, such as AI
+ * turns, should check this periodically and yield to the event loop when
+ * it returns true, so that animation and scrolling keep their frame rate.
+ */
+bool frame_due();
+
+/** Time spent in each phase of a single call to sparkle(). */
+struct frame_timings
+{
+	std::chrono::microseconds update{0};
+	std::chrono::microseconds layout{0};
+	std::chrono::microseconds render{0};
+	std::chrono::microseconds expose{0};
+	/** Flipping the screen, or waiting for vsync if nothing was drawn. */
+	std::chrono::microseconds present{0};
+
+	/** Time between the end of the previous sparkle() and the start of this one. */
+	std::chrono::microseconds outside{0};
+
+	std::chrono::microseconds total() const
+	{
+		return update + layout + render + expose + present;
+	}
+};
+
+/** Phase timings of the most recently completed call to sparkle(). */
+const frame_timings& last_frame_timings();
+
 /** Register a top-level drawable.
  *
  * Registered drawables will be drawn in the order of registration,
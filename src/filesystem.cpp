@@ -51,6 +51,7 @@
 #endif /* !_WIN32 */
 
 #include <algorithm>
+#include <mutex>
 #include <set>
 
 // Copied from boost::predef, as it's there only since 1.55.
@@ -803,6 +804,18 @@ bool rename_dir(const std::string& old_dir, const std::string& new_dir)
 	return true;
 }
 
+bool rename_file(const std::string& old_name, const std::string& new_name)
+{
+	error_code ec;
+	bfs::rename(old_name, new_name, ec);
+
+	if(ec) {
+		ERR_FS << "Failed to rename file '" << old_name << "' to '" << new_name << "': " << ec.message();
+		return false;
+	}
+	return true;
+}
+
 static void set_user_config_path(bfs::path newconfig)
 {
 	user_config_dir = newconfig;
@@ -1413,6 +1426,9 @@ std::set<std::string> binary_paths;
 typedef std::map<std::string, std::vector<std::string>> paths_map;
 paths_map binary_paths_cache;
 
+// the terrain builder may look up images on another thread while the game starts
+std::mutex binary_paths_cache_mutex;
+
 } // namespace
 
 static void init_binary_paths()
@@ -1461,7 +1477,7 @@ void binary_paths_manager::set_paths(const game_config_view& cfg)
 
 void binary_paths_manager::cleanup()
 {
-	binary_paths_cache.clear();
+	clear_binary_paths_cache();
 
 	for(const std::string& p : paths_) {
 		binary_paths.erase(p);
@@ -1470,6 +1486,7 @@ void binary_paths_manager::cleanup()
 
 void clear_binary_paths_cache()
 {
+	std::scoped_lock lock(binary_paths_cache_mutex);
 	binary_paths_cache.clear();
 }
 
@@ -1515,6 +1532,7 @@ static bool is_legal_file(const std::string& filename_str)
  */
 const std::vector<std::string>& get_binary_paths(const std::string& type)
 {
+	std::scoped_lock lock(binary_paths_cache_mutex);
 	const paths_map::const_iterator itor = binary_paths_cache.find(type);
 	if(itor != binary_paths_cache.end()) {
 		return itor->second;
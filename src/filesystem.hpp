@@ -160,6 +160,9 @@ std::string get_core_images_dir();
 
 bool rename_dir(const std::string& old_dir, const std::string& new_dir);
 
+/** Renames a file, replacing @a new_name if it exists. */
+bool rename_file(const std::string& old_name, const std::string& new_name);
+
 struct other_version_dir
 {
 	/**
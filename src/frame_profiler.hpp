@@ -0,0 +1,242 @@
+/*
+	Copyright (C) 2024 - 2024
+	by the Battle for Wesnoth developers
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+/**
+ * Lightweight instrumentation of the drawing code.
+ *
+ * Interesting parts of the drawing code are wrapped in a frame_profiler::scope,
+ * which adds the time spent inside it to the totals of the current frame.
+ * draw_manager::sparkle() closes each frame by calling end_frame().
+ *
+ * The profiler is disabled by default, in which case a scope costs a single
+ * branch and nothing is recorded. While enabled, the most recent frames are
+ * kept for the on-screen overlay and can be written out as CSV or as a
+ * Chrome trace (load it in chrome://tracing or Perfetto).
+ *
+ * Sections may nest (texture uploads happen while drawing hexes, for
+ * example), so their times should not be summed.
+ */
+namespace frame_profiler
+{
+enum class section : std::size_t {
+	draw_invalidated,
+	draw_hex,
+	drawing_buffer_commit,
+	reports,
+	minimap,
+	halos,
+	floating_labels,
+	texture_upload,
+	image_cache_miss,
+	count
+};
+
+constexpr std::size_t num_sections = static_cast<std::size_t>(section::count);
+
+constexpr std::array<const char*, num_sections> section_names {
+	"draw_invalidated",
+	"draw_hex",
+	"drawing_buffer_commit",
+	"reports",
+	"minimap",
+	"halos",
+	"floating_labels",
+	"texture_upload",
+	"image_cache_miss",
+};
+
+using clock = std::chrono::steady_clock;
+using microseconds = std::chrono::microseconds;
+
+/** Everything recorded during a single frame. */
+struct frame_sample
+{
+	std::array<microseconds, num_sections> time {};
+	std::array<unsigned, num_sections> calls {};
+
+	/** Time spent running drawing buffer entries, indexed by drawing layer. */
+	std::vector<microseconds> layers;
+};
+
+/** A single timed section, as written to the Chrome trace. */
+struct trace_event
+{
+	section sec;
+	clock::time_point start;
+	microseconds duration;
+};
+
+/** Number of completed frames kept while profiling. */
+constexpr std::size_t max_history = 1000;
+
+/** Number of trace events kept while profiling. Later events are dropped. */
+constexpr std::size_t max_trace_events = 1000000;
+
+namespace detail
+{
+struct state
+{
+	bool enabled = false;
+	frame_sample current;
+	std::vector<frame_sample> history;
+	std::vector<trace_event> trace;
+	clock::time_point epoch;
+};
+
+inline state& get()
+{
+	static state s;
+	return s;
+}
+} // namespace detail
+
+inline bool enabled()
+{
+	return detail::get().enabled;
+}
+
+/** Enables or disables profiling. Either way, everything recorded so far is discarded. */
+inline void set_enabled(bool value)
+{
+	detail::state& s = detail::get();
+	s = detail::state();
+	s.enabled = value;
+	s.epoch = clock::now();
+}
+
+/** Adds a timed section to the current frame. */
+inline void record(section sec, clock::time_point start, clock::time_point end)
+{
+	detail::state& s = detail::get();
+	const auto i = static_cast<std::size_t>(sec);
+	const auto duration = std::chrono::duration_cast<microseconds>(end - start);
+
+	s.current.time[i] += duration;
+	++s.current.calls[i];
+
+	if(s.trace.size() < max_trace_events) {
+		s.trace.push_back({sec, start, duration});
+	}
+}
+
+/** Adds time spent drawing one drawing buffer entry on the given layer. */
+inline void record_layer(std::size_t layer, microseconds duration)
+{
+	std::vector<microseconds>& layers = detail::get().current.layers;
+	if(layer >= layers.size()) {
+		layers.resize(layer + 1);
+	}
+
+	layers[layer] += duration;
+}
+
+/** Closes the current frame and starts a new one. Does nothing while disabled. */
+inline void end_frame()
+{
+	detail::state& s = detail::get();
+	if(!s.enabled) {
+		return;
+	}
+
+	if(s.history.size() == max_history) {
+		s.history.erase(s.history.begin());
+	}
+
+	s.history.push_back(std::move(s.current));
+	s.current = frame_sample();
+}
+
+/** The most recently completed frames, oldest first. */
+inline const std::vector<frame_sample>& history()
+{
+	return detail::get().history;
+}
+
+/** Writes one line per recorded frame, with the time and call count of every section. */
+inline void write_csv(std::ostream& out)
+{
+	out << "frame";
+	for(const char* name : section_names) {
+		out << ',' << name << "_us," << name << "_calls";
+	}
+	out << '\n';
+
+	const std::vector<frame_sample>& frames = history();
+	for(std::size_t f = 0; f < frames.size(); ++f) {
+		out << f;
+		for(std::size_t i = 0; i < num_sections; ++i) {
+			out << ',' << frames[f].time[i].count() << ',' << frames[f].calls[i];
+		}
+		out << '\n';
+	}
+}
+
+/** Writes every recorded section in the Chrome trace event format. */
+inline void write_chrome_trace(std::ostream& out)
+{
+	const detail::state& s = detail::get();
+
+	out << "{\"traceEvents\":[";
+	for(std::size_t i = 0; i < s.trace.size(); ++i) {
+		const trace_event& e = s.trace[i];
+		const auto ts = std::chrono::duration_cast<microseconds>(e.start - s.epoch);
+
+		out << (i == 0 ? "\n" : ",\n")
+			<< "{\"name\":\"" << section_names[static_cast<std::size_t>(e.sec)]
+			<< "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << ts.count()
+			<< ",\"dur\":" << e.duration.count() << '}';
+	}
+	out << "\n]}\n";
+}
+
+/** Times the enclosing scope as the given section, if profiling is enabled. */
+class scope
+{
+public:
+	explicit scope(section sec)
+		: section_(sec)
+		, active_(enabled())
+		, start_()
+	{
+		if(active_) {
+			start_ = clock::now();
+		}
+	}
+
+	~scope()
+	{
+		if(active_) {
+			record(section_, start_, clock::now());
+		}
+	}
+
+	scope(const scope&) = delete;
+	scope& operator=(const scope&) = delete;
+
+private:
+	section section_;
+	bool active_;
+	clock::time_point start_;
+};
+
+} // namespace frame_profiler
@@ -40,6 +40,12 @@ game_board::game_board(const config& level)
 	, map_(std::make_unique<gamemap>(level["map_data"]))
 	, unit_id_manager_(level["next_underlying_unit_id"])
 	, units_()
+	, village_owners_()
+	, village_owners_revision_(0)
+	, village_owners_teams_(nullptr)
+	, village_owners_map_(nullptr)
+	, village_owners_width_(0)
+	, village_owners_height_(0)
 {
 }
 
@@ -49,6 +55,12 @@ game_board::game_board(const game_board& other)
 	, map_(new gamemap(*(other.map_)))
 	, unit_id_manager_(other.unit_id_manager_)
 	, units_(other.units_)
+	, village_owners_()
+	, village_owners_revision_(0)
+	, village_owners_teams_(nullptr)
+	, village_owners_map_(nullptr)
+	, village_owners_width_(0)
+	, village_owners_height_(0)
 {
 }
 
@@ -65,6 +77,51 @@ void swap(game_board& one, game_board& other)
 	std::swap(one.units_, other.units_);
 	std::swap(one.unit_id_manager_, other.unit_id_manager_);
 	one.map_.swap(other.map_);
+	one.village_owners_revision_ = other.village_owners_revision_ = 0;
+}
+
+void game_board::update_village_owners() const
+{
+	// A map of the same area but another shape would index the hexes differently.
+	if(village_owners_revision_ == team::villages_revision() && village_owners_teams_ == teams_.data()
+		&& village_owners_map_ == map_.get()
+		&& village_owners_width_ == map_->total_width() && village_owners_height_ == map_->total_height())
+	{
+		return;
+	}
+
+	village_owners_.assign(static_cast<std::size_t>(map_->total_width()) * map_->total_height(), 0);
+	for(std::size_t i = 0; i != teams_.size(); ++i) {
+		for(const map_location& loc : teams_[i].villages()) {
+			if(map_->on_board_with_border(loc)) {
+				const int x = loc.x + map_->border_size();
+				const int y = loc.y + map_->border_size();
+				// Like display_context::village_owner(), the first team owning a village wins.
+				int& owner = village_owners_[static_cast<std::size_t>(y) * map_->total_width() + x];
+				if(owner == 0) {
+					owner = i + 1;
+				}
+			}
+		}
+	}
+
+	village_owners_revision_ = team::villages_revision();
+	village_owners_teams_ = teams_.data();
+	village_owners_map_ = map_.get();
+	village_owners_width_ = map_->total_width();
+	village_owners_height_ = map_->total_height();
+}
+
+int game_board::village_owner(const map_location& loc) const
+{
+	if(!map_->on_board_with_border(loc)) {
+		return display_context::village_owner(loc);
+	}
+
+	update_village_owners();
+	const int x = loc.x + map_->border_size();
+	const int y = loc.y + map_->border_size();
+	return village_owners_[static_cast<std::size_t>(y) * map_->total_width() + x];
 }
 
 void game_board::new_turn(int player_num)
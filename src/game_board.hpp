@@ -51,6 +51,21 @@ class game_board : public display_context
 	n_unit::id_manager unit_id_manager_;
 	unit_map units_;
 
+	/**
+	 * Owning side of every hex including the border, 0 if unowned.
+	 * Rebuilt on demand when the villages of any team, the teams or the map
+	 * changed since it was last built.
+	 */
+	mutable std::vector<int> village_owners_;
+	mutable std::size_t village_owners_revision_;
+	mutable const team* village_owners_teams_;
+	mutable const gamemap* village_owners_map_;
+	/** Size of the map, with the border, when village_owners_ was built. */
+	mutable int village_owners_width_;
+	mutable int village_owners_height_;
+
+	void update_village_owners() const;
+
 	/**
 	 * Temporary unit move structs:
 	 *
@@ -123,6 +138,9 @@ public:
 		return labels_;
 	}
 
+	/** Constant time version of display_context::village_owner(). */
+	virtual int village_owner(const map_location& loc) const override;
+
 	// Copy and swap idiom, because we have a scoped pointer.
 
 	game_board(const game_board & other);
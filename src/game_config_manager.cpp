@@ -61,6 +61,7 @@ game_config_manager::game_config_manager(const commandline_options& cmdline_opts
 	, paths_manager_()
 	, cache_(game_config::config_cache::instance())
 	, achievements_()
+	, revision_(0)
 {
 	assert(!singleton);
 	singleton = this;
@@ -193,6 +194,7 @@ void game_config_manager::load_game_config(bool reload_everything, const game_cl
 
 	// The loadscreen will erase the titlescreen.
 	// NOTE: even without loadscreen, needed after MP lobby.
+	++revision_;
 	try {
 		// Read all game configs.
 		// First we load all core configs, the mainline one and the ones from the addons.
@@ -345,7 +347,7 @@ void game_config_manager::load_game_config(bool reload_everything, const game_cl
 		game_lua_kernel::extract_preload_scripts(game_config());
 
 		set_unit_data();
-		terrain_builder::set_terrain_rules_cfg(game_config());
+		terrain_builder::set_terrain_rules_cfg(game_config(), terrain_rules_key());
 		tdata_ = std::make_shared<terrain_type_data>(game_config());
 		::init_strings(game_config());
 		theme::set_known_themes(&game_config());
@@ -664,6 +666,28 @@ void game_config_manager::set_unit_data()
 	unit_types.set_config(game_config().merged_children_view("units"));
 }
 
+/**
+ * Identifies the terrain graphics rules of the game config, so that the
+ * terrain builder keeps the rules it parsed across reloads that can't have
+ * changed them. They only change with the files of the data tree, the core,
+ * the defines the config was loaded with or the active add-ons.
+ */
+std::string game_config_manager::terrain_rules_key() const
+{
+	const filesystem::file_tree_checksum& checksum = filesystem::data_tree_checksum();
+
+	formatter key;
+	key << checksum.nfiles << ' ' << checksum.sum_size << ' ' << checksum.modified << ' ' << preferences::core_id();
+	for(const auto& define : cache_.get_preproc_map()) {
+		key << ' ' << define.first;
+	}
+	key << " |";
+	for(const std::string& addon : active_addons_) {
+		key << ' ' << addon;
+	}
+	return key.str();
+}
+
 void game_config_manager::reload_changed_game_config()
 {
 	// Rebuild addon version info cache.
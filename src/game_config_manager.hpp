@@ -46,6 +46,12 @@ public:
 	const std::shared_ptr<terrain_type_data>& terrain_types() const { return tdata_; }
 	std::vector<achievement_group>& get_achievements() { return achievements_.get_list(); }
 
+	/**
+	 * Incremented every time the game config is loaded, so that data derived
+	 * from it (such as the help contents) can tell when it needs rebuilding.
+	 */
+	std::size_t revision() const { return revision_; }
+
 	bool init_game_config(FORCE_RELOAD_CONFIG force_reload);
 	void reload_changed_game_config();
 
@@ -70,6 +76,7 @@ private:
 	void load_addons_cfg();
 	void set_multiplayer_hashes();
 	void set_unit_data();
+	std::string terrain_rules_key() const;
 
 	const commandline_options& cmdline_opts_;
 
@@ -88,4 +95,6 @@ private:
 	std::shared_ptr<terrain_type_data> tdata_;
 
 	achievements achievements_;
+
+	std::size_t revision_;
 };
@@ -21,6 +21,7 @@
 #include "game_display.hpp"
 
 
+#include "actions/undo.hpp"
 #include "cursor.hpp"
 #include "display_chat_manager.hpp"
 #include "fake_unit_manager.hpp"
@@ -42,6 +43,8 @@
 #include "overlay.hpp"
 #include "draw.hpp"
 
+#include <tuple>
+
 static lg::log_domain log_display("display");
 #define ERR_DP LOG_STREAM(err, log_display)
 #define LOG_DP LOG_STREAM(info, log_display)
@@ -71,6 +74,7 @@ game_display::game_display(game_board& board,
 	, attack_indicator_dst_()
 	, route_()
 	, displayedUnitHex_()
+	, report_inputs_()
 	, first_turn_(true)
 	, in_game_(false)
 	, chat_man_(new display_chat_manager(*this))
@@ -121,20 +125,18 @@ void game_display::highlight_hex(map_location hex)
 	const unit *u = resources::gameboard->get_visible_unit(hex, dc_->teams()[viewing_team()], !dont_show_all_);
 	if (u) {
 		displayedUnitHex_ = hex;
-		invalidate_unit();
 	} else {
 		u = resources::gameboard->get_visible_unit(mouseoverHex_, dc_->teams()[viewing_team()], !dont_show_all_);
 		if (u) {
 			// mouse moved from unit hex to non-unit hex
 			if (dc_->units().count(selectedHex_)) {
 				displayedUnitHex_ = selectedHex_;
-				invalidate_unit();
 			}
 		}
 	}
 
 	display::highlight_hex(hex);
-	invalidate_game_status();
+	invalidate_reports(reports::DEP_MOUSEOVER);
 }
 
 
@@ -148,7 +150,7 @@ void game_display::display_unit_hex(map_location hex)
 	const unit *u = resources::gameboard->get_visible_unit(hex, dc_->teams()[viewing_team()], !dont_show_all_);
 	if (u) {
 		displayedUnitHex_ = hex;
-		invalidate_unit();
+		invalidate_reports(reports::DEP_MOUSEOVER);
 	}
 }
 
@@ -333,6 +335,18 @@ void game_display::draw_hex(const map_location& loc)
 	}
 }
 
+void game_display::write_debug_stats(std::ostream& out) const
+{
+	if(!resources::undo_stack) {
+		return;
+	}
+
+	const actions::undo_list::stats undo_stats = resources::undo_stack->get_stats();
+	out << "\n<tt>undo: " << undo_stats.undos << " actions, " << undo_stats.undo_bytes / 1024 << " KiB ("
+		<< undo_stats.wml_bytes / 1024 << " KiB wml), redo: " << undo_stats.redos << " actions, "
+		<< undo_stats.redo_bytes / 1024 << " KiB</tt>";
+}
+
 const time_of_day& game_display::get_time_of_day(const map_location& loc) const
 {
 	return resources::tod_manager->get_time_of_day(loc);
@@ -358,13 +372,110 @@ void game_display::layout()
 	{
 		wb::future_map future; // start planned unit map scope
 
+		const unsigned dirty = invalidatedReportDependencies_ | changed_report_inputs() | reports::DEP_UNTRACKED;
+
 		// We display the unit the mouse is over if it is over a unit,
 		// otherwise we display the unit that is selected.
 		for (const std::string &name : reports_object_->report_list()) {
-			refresh_report(name);
+			// Reports that were never drawn still need their location set up.
+			if ((reports_object_->dependencies(name) & dirty) != 0 || reports_.count(name) == 0) {
+				refresh_report(name);
+			}
 		}
 		invalidateGameStatus_ = false;
+		invalidatedReportDependencies_ = reports::DEP_NONE;
+	}
+}
+
+bool game_display::unit_report_state::operator==(const unit_report_state& other) const
+{
+	return std::tie(id, side, level, hitpoints, max_hitpoints, experience, max_experience, moves, max_moves, attacks, type, name, states, modifications)
+		== std::tie(other.id, other.side, other.level, other.hitpoints, other.max_hitpoints, other.experience, other.max_experience,
+			other.moves, other.max_moves, other.attacks, other.type, other.name, other.states, other.modifications);
+}
+
+game_display::unit_report_state game_display::get_unit_report_state(const map_location& hex) const
+{
+	unit_report_state state;
+	const unit_map::const_iterator u = dc_->units().find(hex);
+	if(u == dc_->units().end()) {
+		return state;
+	}
+
+	state.id = u->underlying_id();
+	state.side = u->side();
+	state.level = u->level();
+	state.hitpoints = u->hitpoints();
+	state.max_hitpoints = u->max_hitpoints();
+	state.experience = u->experience();
+	state.max_experience = u->max_experience();
+	state.moves = u->movement_left();
+	state.max_moves = u->total_movement();
+	state.attacks = u->attacks_left();
+	state.type = u->type_id();
+	state.name = u->name().str();
+	state.states = u->get_states();
+	state.modifications = u->get_modifications().all_children_count();
+	return state;
+}
+
+unsigned game_display::changed_report_inputs()
+{
+	const team& viewing = dc_->teams()[viewing_team()];
+	int gold = viewing.gold();
+	if(std::shared_ptr<wb::manager> w = wb_.lock()) {
+		gold -= w->get_spent_gold_for(viewing_side());
+	}
+
+	const team_data side_data(*dc_, viewing);
+
+	report_inputs current {
+		mouseoverHex_,
+		displayedUnitHex_,
+		selectedHex_,
+		viewing_team(),
+		playing_team(),
+		show_everything(),
+		gold,
+		resources::tod_manager->turn(),
+		resources::tod_manager->get_time_of_day().id,
+		team::villages_revision(),
+		side_data.units,
+		side_data.upkeep,
+		side_data.expenses,
+		side_data.net_income,
+		get_unit_report_state(displayedUnitHex_),
+		get_unit_report_state(selectedHex_),
+	};
+
+	unsigned changed = reports::DEP_NONE;
+	if(current.mouseover_hex != report_inputs_.mouseover_hex || current.displayed_unit_hex != report_inputs_.displayed_unit_hex) {
+		changed |= reports::DEP_MOUSEOVER;
+	}
+	if(current.selected_hex != report_inputs_.selected_hex) {
+		changed |= reports::DEP_SELECTED_UNIT;
+	}
+	if(current.viewing_team != report_inputs_.viewing_team || current.playing_team != report_inputs_.playing_team
+		|| current.show_everything != report_inputs_.show_everything)
+	{
+		changed |= reports::DEP_VIEWING_TEAM;
+	}
+	if(current.gold != report_inputs_.gold) {
+		changed |= reports::DEP_GOLD;
+	}
+	if(current.turn != report_inputs_.turn || current.tod_id != report_inputs_.tod_id) {
+		changed |= reports::DEP_TOD;
 	}
+	if(current.villages_revision != report_inputs_.villages_revision || current.units != report_inputs_.units
+		|| current.upkeep != report_inputs_.upkeep || current.expenses != report_inputs_.expenses
+		|| current.net_income != report_inputs_.net_income || current.displayed_unit != report_inputs_.displayed_unit
+		|| current.selected_unit != report_inputs_.selected_unit)
+	{
+		changed |= reports::DEP_UNITS;
+	}
+
+	report_inputs_ = std::move(current);
+	return changed;
 }
 
 
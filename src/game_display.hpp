@@ -22,6 +22,8 @@ class game_board;
 #include "display_chat_manager.hpp"
 #include "pathfind/pathfind.hpp"
 
+#include <set>
+
 
 // This needs to be separate from display.h because of the static
 // singleton member, which will otherwise trigger link failure
@@ -123,7 +125,7 @@ public:
 	void draw_movement_info(const map_location& loc);
 
 	/** Function to invalidate that unit status displayed on the sidebar. */
-	void invalidate_unit() { invalidateGameStatus_ = true; }
+	void invalidate_unit() { invalidate_reports(reports::DEP_UNITS); }
 
 	/** Same as invalidate_unit() if moving the displayed unit. */
 	void invalidate_unit_after_move(const map_location& src, const map_location& dst);
@@ -163,6 +165,9 @@ protected:
 
 	virtual void draw_hex(const map_location& loc) override;
 
+	/** Adds the size of the undo and redo stacks. */
+	virtual void write_debug_stats(std::ostream& out) const override;
+
 	/** Inherited from display. */
 	virtual overlay_map& get_overlays() override;
 
@@ -242,6 +247,55 @@ private:
 
 	map_location displayedUnitHex_;
 
+	/**
+	 * What the sidebar shows of a single unit. Units are also changed by
+	 * WML and Lua, which do not tell the display, so this is compared too.
+	 */
+	struct unit_report_state
+	{
+		std::size_t id = 0;
+		int side = 0, level = 0;
+		int hitpoints = 0, max_hitpoints = 0;
+		int experience = 0, max_experience = 0;
+		int moves = 0, max_moves = 0, attacks = 0;
+		std::string type, name;
+		std::set<std::string> states;
+		std::size_t modifications = 0;
+
+		bool operator==(const unit_report_state& other) const;
+		bool operator!=(const unit_report_state& other) const { return !(*this == other); }
+	};
+
+	unit_report_state get_unit_report_state(const map_location& hex) const;
+
+	/** Inputs of the sidebar reports as of their last refresh, see reports::dependency. */
+	struct report_inputs
+	{
+		map_location mouseover_hex;
+		map_location displayed_unit_hex;
+		map_location selected_hex;
+		std::size_t viewing_team = 0;
+		std::size_t playing_team = 0;
+		bool show_everything = false;
+		int gold = 0;
+		int turn = 0;
+		std::string tod_id;
+		/** team::villages_revision() */
+		std::size_t villages_revision = 0;
+		/** The team_data of the viewing team. */
+		int units = 0, upkeep = 0, expenses = 0, net_income = 0;
+		unit_report_state displayed_unit;
+		unit_report_state selected_unit;
+	};
+
+	report_inputs report_inputs_;
+
+	/**
+	 * Compares the current report inputs with those of the last refresh.
+	 * @returns the reports::dependency bits that changed.
+	 */
+	unsigned changed_report_inputs();
+
 	bool first_turn_, in_game_;
 
 	const std::unique_ptr<display_chat_manager> chat_man_;
@@ -224,6 +224,8 @@ void wml_event_pump::process_event(handler_ptr& handler_p, const queued_event& e
 
 	if(game_display::get_singleton() != nullptr) {
 		game_display::get_singleton()->maybe_rebuild();
+		// WML and Lua change units, villages and gold without telling the display.
+		game_display::get_singleton()->invalidate_game_status();
 	}
 }
 
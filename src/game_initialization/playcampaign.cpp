@@ -31,6 +31,7 @@
 #include "gui/dialogs/message.hpp"
 #include "gui/dialogs/outro.hpp"
 #include "gui/widgets/retval.hpp"
+#include "load_profiler.hpp"
 #include "log.hpp"
 #include "map/exception.hpp"
 #include "playmp_controller.hpp"
@@ -112,6 +113,7 @@ level_result::type campaign_controller::play_game()
 		state_.get_replay().set_to_end();
 	}
 
+	load_profiler::start_load();
 	state_.expand_scenario();
 
 	while(state_.valid()) {
@@ -228,6 +230,7 @@ level_result::type campaign_controller::play_game()
 			// otherwise it keeps getting appended for each scenario resulting in incorrect data being sent to the server to be stored
 			state_.mp_settings().addons.clear();
 			// Retrieve next scenario data.
+			load_profiler::start_load();
 			state_.expand_scenario();
 
 			if(state_.valid()) {
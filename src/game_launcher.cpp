@@ -38,6 +38,7 @@
 #include "gui/dialogs/transient_message.hpp" // for show_transient_message
 #include "gui/widgets/settings.hpp"          // for new_widgets
 #include "language.hpp"                      // for language_def, etc
+#include "load_profiler.hpp"
 #include "log.hpp"                           // for LOG_STREAM, logger, general, etc
 #include "map/exception.hpp"
 #include "preferences/credentials.hpp"
@@ -57,8 +58,10 @@
 #include <boost/process/windows.hpp>
 #endif
 #include <boost/process.hpp>
+#include <chrono>
 #include <cstdlib>   // for system
 #include <new>
+#include <optional>
 #include <utility> // for pair
 
 
@@ -201,6 +204,10 @@ game_launcher::game_launcher(const commandline_options& cmdline_opts)
 		no_music = true;
 	if(cmdline_opts_.nosound)
 		no_sound = true;
+	if(cmdline_opts_.profile_load_file) {
+		load_profiler::set_output(*cmdline_opts_.profile_load_file,
+			*cmdline_opts_.profile_load_format == "chrome" ? load_profiler::output_format::chrome_trace : load_profiler::output_format::json);
+	}
 	if(cmdline_opts_.resolution) {
 		const int xres = std::get<0>(*cmdline_opts_.resolution);
 		const int yres = std::get<1>(*cmdline_opts_.resolution);
@@ -495,7 +502,10 @@ bool game_launcher::play_test()
  * Runs unit tests specified on the command line.
  *
  * If multiple unit tests were specified, then this will stop at the first test
- * which returns a non-zero status.
+ * which returns a non-zero status, unless --unit-report was given. In that case
+ * every test is run, and its result is appended to the report as soon as it is
+ * known, so that a test runner can tell which test was running if the process
+ * hangs or crashes.
  */
 // Same as play_test except that we return the results of play_game.
 // \todo "same ... except" ... and many other changes, such as testing the replay
@@ -507,10 +517,31 @@ game_launcher::unit_test_result game_launcher::unit_test()
 		return unit_test_result::TEST_FAIL;
 	}
 
+	filesystem::scoped_ostream report;
+	if(cmdline_opts_.unit_test_report) {
+		try {
+			report = filesystem::ostream_file(*cmdline_opts_.unit_test_report);
+		} catch(const filesystem::io_exception& e) {
+			PLAIN_LOG << "could not open the unit test report " << *cmdline_opts_.unit_test_report << ": " << e.what();
+			return unit_test_result::TEST_FAIL;
+		}
+	}
+
 	auto ret = unit_test_result::TEST_FAIL; // will only be returned if no test is run
+	std::optional<unit_test_result> first_failure;
+	bool first_test = true;
 	for(const auto& scenario : test_scenarios_) {
+		// With a report every test is run, so each one is judged on its own messages rather than
+		// on those of the tests run before it. Messages logged before the first test still count.
+		if(report && !first_test) {
+			lg::clear_broke_strict();
+		}
+		first_test = false;
 		set_test(scenario);
+
+		const auto start = std::chrono::steady_clock::now();
 		ret = single_unit_test();
+		const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
 		const char* describe_result;
 		switch(ret) {
 		case unit_test_result::TEST_PASS:
@@ -549,12 +580,23 @@ game_launcher::unit_test_result game_launcher::unit_test()
 		}
 
 		PLAIN_LOG << describe_result << " (" << int(ret) << "): " << scenario;
+
+		if(report) {
+			*report << int(ret) << ' ' << duration.count() << ' ' << scenario << std::endl;
+		}
+
 		if(ret != unit_test_result::TEST_PASS) {
-			break;
+			if(!report) {
+				break;
+			}
+
+			if(!first_failure) {
+				first_failure = ret;
+			}
 		}
 	}
 
-	return ret;
+	return first_failure.value_or(ret);
 }
 
 game_launcher::unit_test_result game_launcher::single_unit_test()
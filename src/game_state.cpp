@@ -19,6 +19,7 @@
 #include "game_board.hpp"
 #include "game_data.hpp"
 #include "game_events/manager.hpp"
+#include "load_profiler.hpp"
 #include "log.hpp"
 #include "map/map.hpp"
 #include "pathfind/pathfind.hpp"
@@ -145,7 +146,11 @@ void game_state::place_sides_in_preferred_locations(const config& level)
 
 void game_state::init(const config& level, play_controller & pc)
 {
-	events_manager_->read_scenario(level, *lua_kernel_);
+	{
+		load_profiler::scope profile("event handler registration");
+		events_manager_->read_scenario(level, *lua_kernel_);
+	}
+
 	gui2::dialogs::loading_screen::progress(loading_stage::init_teams);
 	if (level["modify_placing"].to_bool()) {
 		LOG_NG << "modifying placing...";
@@ -183,9 +188,13 @@ void game_state::init(const config& level, play_controller & pc)
 	}
 
 	//Initialize the lua kernel before the units are created.
-	lua_kernel_->initialize(level);
+	{
+		load_profiler::scope profile("lua kernel");
+		lua_kernel_->initialize(level);
+	}
 
 	{
+		load_profiler::scope profile("sides and units");
 		//sync traits of start units and the random start time.
 		randomness::set_random_determinstic deterministic(gamedata_.rng());
 
@@ -17,9 +17,14 @@
 #include "filesystem.hpp"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <iterator>
 #include <locale>
 #include <map>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
 #include <boost/locale.hpp>
 #include <set>
 #include <type_traits>
@@ -207,6 +212,89 @@ namespace
 		std::locale base_loc_;
 		std::map<int, spirit_po::default_catalog> extra_messages_;
 	};
+
+	/**
+	 * Results of dsgettext(), so that each (domain, msgid) pair only goes
+	 * through boost::locale once per language.
+	 *
+	 * The table is split into shards with their own lock, as strings are also
+	 * translated by the loading screen's worker thread.
+	 */
+	class translation_cache
+	{
+	public:
+		/** Identifies the language the cached translations belong to. */
+		unsigned generation() const
+		{
+			return generation_;
+		}
+
+		/** Returns the cached translation, or nullopt if there is none for the current language. */
+		std::optional<std::string> find(const std::string& key)
+		{
+			shard& s = get_shard(key);
+			std::lock_guard lock(s.mutex);
+			sync(s);
+			auto it = s.translations.find(key);
+			if(it == s.translations.end()) {
+				return std::nullopt;
+			}
+			return it->second;
+		}
+
+		/**
+		 * Caches a translation looked up while generation() returned @a generation.
+		 * It is dropped if the language changed in the meantime.
+		 */
+		void insert(const std::string& key, const std::string& translation, unsigned generation)
+		{
+			shard& s = get_shard(key);
+			std::lock_guard lock(s.mutex);
+			sync(s);
+			if(s.generation == generation) {
+				s.translations.emplace(key, translation);
+			}
+		}
+
+		/** Drops every cached translation, e.g. when the language changes. */
+		void invalidate()
+		{
+			++generation_;
+		}
+
+	private:
+		struct shard
+		{
+			std::mutex mutex;
+			std::unordered_map<std::string, std::string> translations;
+			unsigned generation = 0;
+		};
+
+		shard& get_shard(const std::string& key)
+		{
+			return shards_[std::hash<std::string>{}(key) % shards_.size()];
+		}
+
+		/** Empties the shard if the cache was invalidated since its last use. The shard must be locked. */
+		void sync(shard& s) const
+		{
+			const unsigned generation = generation_;
+			if(s.generation != generation) {
+				s.translations.clear();
+				s.generation = generation;
+			}
+		}
+
+		std::array<shard, 16> shards_;
+		std::atomic<unsigned> generation_ {0};
+	};
+
+	translation_cache& get_cache()
+	{
+		static translation_cache* cache = new translation_cache();
+		return *cache;
+	}
+
 	struct translation_manager
 	{
 		translation_manager()
@@ -296,6 +384,7 @@ namespace
 		void update_locale()
 		{
 			is_dirty_ = true;
+			get_cache().invalidate();
 		}
 
 		/* This is called three times: once during the constructor, before any .mo files' paths have
@@ -433,6 +522,16 @@ std::string egettext(char const *msgid)
 
 std::string dsgettext (const char * domainname, const char *msgid)
 {
+	// Neither part can contain a null character, so this key is unambiguous.
+	std::string key(domainname);
+	key.push_back('\0');
+	key.append(msgid);
+
+	const unsigned generation = get_cache().generation();
+	if(std::optional<std::string> cached = get_cache().find(key)) {
+		return *std::move(cached);
+	}
+
 	std::string msgval = dgettext (domainname, msgid);
 	if (msgval == msgid) {
 		const char* firsthat = std::strchr (msgid, '^');
@@ -441,6 +540,8 @@ std::string dsgettext (const char * domainname, const char *msgid)
 		else
 			msgval = firsthat + 1;
 	}
+
+	get_cache().insert(key, msgval, generation);
 	return msgval;
 }
 
@@ -29,6 +29,7 @@ namespace gui2
 gui_theme_map_t guis;
 gui_theme_map_t::iterator current_gui = guis.end();
 gui_theme_map_t::iterator default_gui = guis.end();
+unsigned gui_generation = 0;
 
 gui_definition::gui_definition(const config& cfg)
 	: widget_types()
@@ -198,7 +199,9 @@ const typename TList::value_type& get_best_resolution(const TList& list, const T
 
 } // namespace
 
-resolution_definition_ptr get_control(const std::string& control_type, const std::string& definition)
+namespace
+{
+resolution_definition_ptr find_control(const std::string& control_type, const std::string& definition)
 {
 	const auto& current_types = current_gui->second.widget_types;
 	const auto& default_types = default_gui->second.widget_types;
@@ -231,7 +234,7 @@ resolution_definition_ptr get_control(const std::string& control_type, const std
 			if(definition != "default") {
 				LOG_GUI_G << "Control: type '" << control_type << "' definition '" << definition
 						  << "' not found, falling back to 'default'.";
-				return get_control(control_type, "default");
+				return find_control(control_type, "default");
 			}
 
 			FAIL(formatter() << "default definition not found for styled_widget " << control_type);
@@ -251,6 +254,56 @@ resolution_definition_ptr get_control(const std::string& control_type, const std
 	});
 }
 
+/**
+ * Results of find_control, since every widget of every dialog asks for its
+ * definition when it is built.
+ *
+ * The results depend on the GUI definitions and the screen size, so the cache
+ * is emptied whenever @ref gui_generation or the screen size changes.
+ */
+struct control_cache
+{
+	unsigned generation = 0;
+	unsigned screen_width = 0;
+	unsigned screen_height = 0;
+	/** Control type -> definition -> result, searchable without copying the names. */
+	std::map<std::string, std::map<std::string, resolution_definition_ptr, std::less<>>, std::less<>> controls;
+};
+
+control_cache& get_control_cache()
+{
+	static control_cache cache;
+	return cache;
+}
+} // namespace
+
+resolution_definition_ptr get_control(const std::string& control_type, const std::string& definition)
+{
+	control_cache& cache = get_control_cache();
+	if(cache.generation != gui_generation
+		|| cache.screen_width != settings::screen_width
+		|| cache.screen_height != settings::screen_height
+	) {
+		cache.controls.clear();
+		cache.generation = gui_generation;
+		cache.screen_width = settings::screen_width;
+		cache.screen_height = settings::screen_height;
+	}
+
+	auto type_iter = cache.controls.find(control_type);
+	if(type_iter != cache.controls.end()) {
+		auto iter = type_iter->second.find(definition);
+		if(iter != type_iter->second.end()) {
+			return iter->second;
+		}
+	}
+
+	// Resolve before inserting anything, so a lookup that throws leaves no entry behind.
+	resolution_definition_ptr result = find_control(control_type, definition);
+	cache.controls[control_type].emplace(definition, result);
+	return result;
+}
+
 const builder_window::window_resolution& get_window_builder(const std::string& type)
 {
 	settings::update_screen_size_variables();
@@ -300,6 +353,7 @@ bool add_single_widget_definition(const std::string& widget_type, const std::str
 	}
 
 	def_map.emplace(definition_id, parser->second.parser(cfg));
+	++gui_generation;
 	return true;
 }
 
@@ -310,6 +364,7 @@ void remove_single_widget_definition(const std::string& widget_type, const std::
 	auto it = definition_map.find(definition_id);
 	if(it != definition_map.end()) {
 		definition_map.erase(it);
+		++gui_generation;
 	}
 }
 
@@ -92,6 +92,12 @@ extern gui_theme_map_t::iterator current_gui;
 /** Iterator pointing to the default GUI. */
 extern gui_theme_map_t::iterator default_gui;
 
+/**
+ * Incremented whenever @ref guis, @ref current_gui or the widget definitions
+ * of the current GUI change, so that cached lookups can tell they are stale.
+ */
+extern unsigned gui_generation;
+
 /**
  * Returns the appropriate config data for a widget instance fom the active
  * GUI definition.
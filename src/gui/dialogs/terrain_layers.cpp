@@ -48,7 +48,7 @@ void terrain_layers::pre_show(window& window)
 	//
 	// List terrain flags
 	//
-	std::vector<std::string> flags(tile_->flags.begin(), tile_->flags.end());
+	std::vector<std::string> flags = tile_->flag_names();
 
 	for(auto& flag : flags) {
 		flag = (formatter() << font::unicode_bullet << " " << flag).str();
@@ -92,6 +92,7 @@ void init()
 	}
 
 	current_gui->second.activate();
+	++gui_generation;
 
 	initialized = true;
 }
@@ -31,6 +31,7 @@
 #include "help/help_browser.hpp"        // for help_browser
 #include "help/help_impl.hpp"           // for hidden_symbol, toplevel, etc
 #include "key.hpp"                      // for CKey
+#include "language.hpp"                 // for get_language
 #include "log.hpp"                      // for LOG_STREAM, log_domain
 #include "show_dialog.hpp"              // for dialog_frame, etc
 #include "terrain/terrain.hpp"          // for terrain_type
@@ -41,6 +42,7 @@
 
 #include <cassert>                      // for assert
 #include <algorithm>                    // for min
+#include <utility>                      // for move
 #include <vector>                       // for vector, vector<>::iterator
 
 
@@ -123,13 +125,9 @@ std::unique_ptr<help_manager> ensure_cache_lifecycle()
 
 help_manager::~help_manager()
 {
+	// The generated contents are kept, show_with_toplevel() regenerates them
+	// if the game config has changed by the next time the help is opened.
 	game_cfg = nullptr;
-	default_toplevel.clear();
-	hidden_sections.clear();
-	// These last numbers must be reset so that the content is regenerated.
-	// Upon next start.
-	last_num_encountered_units = -1;
-	last_num_encountered_terrains = -1;
 }
 
 /**
@@ -212,19 +210,27 @@ void show_with_toplevel(const section &toplevel_sec,
 	);
 	f.layout(xloc, yloc, width, height);
 
-	// Find all unit_types that have not been constructed yet and fill in the information
-	// needed to create the help topics
-	unit_types.build_all(unit_type::HELP_INDEXED);
+	contents_source source;
+	source.cfg = game_cfg;
+	source.config_revision = game_config_manager::get() ? game_config_manager::get()->revision() : 0;
+	source.locale = get_language().localename;
+	source.terrain_types = load_terrain_types_data();
 
 	if (preferences::encountered_units().size() != size_t(last_num_encountered_units) ||
 		preferences::encountered_terrains().size() != size_t(last_num_encountered_terrains) ||
 		last_debug_state != game_config::debug ||
+		last_contents_source != source ||
 		last_num_encountered_units < 0)
 	{
-		// More units or terrains encountered, update the contents.
+		// More units or terrains encountered, or the game config changed, update the contents.
 		last_num_encountered_units = preferences::encountered_units().size();
 		last_num_encountered_terrains = preferences::encountered_terrains().size();
 		last_debug_state = game_config::debug;
+		last_contents_source = std::move(source);
+
+		// Find all unit_types that have not been constructed yet and fill in the information
+		// needed to create the help topics
+		unit_types.build_all(unit_type::HELP_INDEXED);
 		generate_contents();
 	}
 	try {
@@ -70,6 +70,7 @@ help::section hidden_sections;
 int last_num_encountered_units = -1;
 int last_num_encountered_terrains = -1;
 boost::tribool last_debug_state = boost::indeterminate;
+contents_source last_contents_source;
 
 std::vector<std::string> empty_string_vector;
 const int max_section_level = 15;
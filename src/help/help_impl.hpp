@@ -346,6 +346,33 @@ extern int last_num_encountered_units;
 extern int last_num_encountered_terrains;
 extern boost::tribool last_debug_state;
 
+/**
+ * What the current contents were generated from.
+ *
+ * The contents are kept between help_manager lifetimes, so that opening the
+ * help again does not regenerate every section. Generated topics refer to
+ * unit and terrain types directly, so they have to be regenerated as soon as
+ * any of these change.
+ */
+struct contents_source
+{
+	const game_config_view* cfg = nullptr;
+	std::size_t config_revision = 0;
+	std::string locale;
+	/** Kept alive, since the terrain topics refer into it. */
+	std::shared_ptr<terrain_type_data> terrain_types;
+
+	bool operator==(const contents_source& o) const
+	{
+		return cfg == o.cfg && config_revision == o.config_revision && locale == o.locale
+			&& terrain_types == o.terrain_types;
+	}
+
+	bool operator!=(const contents_source& o) const { return !(*this == o); }
+};
+
+extern contents_source last_contents_source;
+
 extern std::vector<std::string> empty_string_vector;
 extern const int max_section_level;
 extern const int title_size;
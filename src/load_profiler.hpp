@@ -0,0 +1,292 @@
+/*
+	Copyright (C) 2024 - 2024
+	by the Battle for Wesnoth developers
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#pragma once
+
+#include "filesystem.hpp"
+#include "log.hpp"
+#include "utils/optimer.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * Hierarchical timing of scenario loads.
+ *
+ * A load starts when the campaign controller begins preparing a scenario
+ * (start_load()) and ends once its start event has been fired (finish_load()).
+ * In between, every load_profiler::scope opened adds its time to a node of the
+ * timing tree, below the node of the innermost enclosing scope. Scopes with the
+ * same name under the same parent share a node, so per-unit work such as
+ * unit::init shows up as a single node with a call count.
+ *
+ * The profiler is only enabled by the --profile-load command line option, in
+ * which case the tree of every load so far is written to the given file after
+ * each load, either as JSON or as a Chrome trace (load it in chrome://tracing
+ * or Perfetto). While disabled, a scope costs a single branch.
+ */
+namespace load_profiler
+{
+using microseconds = std::chrono::microseconds;
+using timer = utils::optimer<microseconds>;
+
+enum class output_format { json, chrome_trace };
+
+/** A phase of a scenario load, and the phases nested in it. */
+struct node
+{
+	explicit node(std::string node_name)
+		: name(std::move(node_name))
+	{
+	}
+
+	std::string name;
+	microseconds time {};
+	unsigned calls = 0;
+	std::vector<node> children;
+
+	/** Returns the child called @a child_name, adding it if needed. */
+	node& child(const char* child_name)
+	{
+		for(node& c : children) {
+			if(c.name == child_name) {
+				return c;
+			}
+		}
+
+		children.emplace_back(child_name);
+		return children.back();
+	}
+};
+
+/** A single timed scope, as written to the Chrome trace. */
+struct trace_event
+{
+	const char* name;
+	timer::point start;
+	microseconds duration;
+};
+
+/** Number of trace events kept per load. Later events are dropped. */
+constexpr std::size_t max_trace_events = 100000;
+
+namespace detail
+{
+struct state
+{
+	std::optional<std::string> output;
+	output_format format = output_format::json;
+	timer::point epoch;
+
+	bool loading = false;
+	/** The thread loading the scenario. Scopes on other threads are ignored. */
+	std::thread::id thread;
+	timer::point load_start;
+	node current {"load"};
+	/** The nodes of the open scopes, innermost last. Parents never reallocate while a child is open. */
+	std::vector<node*> stack;
+	std::vector<trace_event> events;
+
+	/** The finished loads, and when each of them started. */
+	std::vector<node> loads;
+	std::vector<timer::point> load_starts;
+	std::vector<trace_event> trace;
+};
+
+inline state& get()
+{
+	static state s;
+	return s;
+}
+
+inline void write_json_string(std::ostream& out, const std::string& str)
+{
+	out << '"';
+	for(char c : str) {
+		if(c == '"' || c == '\\') {
+			out << '\\' << c;
+		} else if(static_cast<unsigned char>(c) < 0x20) {
+			out << ' ';
+		} else {
+			out << c;
+		}
+	}
+	out << '"';
+}
+
+inline void write_json_node(std::ostream& out, const node& n)
+{
+	out << "{\"name\":";
+	write_json_string(out, n.name);
+	out << ",\"time_us\":" << n.time.count() << ",\"calls\":" << n.calls << ",\"children\":[";
+	for(std::size_t i = 0; i < n.children.size(); ++i) {
+		out << (i == 0 ? "" : ",");
+		write_json_node(out, n.children[i]);
+	}
+	out << "]}";
+}
+} // namespace detail
+
+/** Whether a load is currently being profiled. */
+inline bool active()
+{
+	const detail::state& s = detail::get();
+	return s.loading && s.thread == std::this_thread::get_id();
+}
+
+/** Enables the profiler. Every load is written to @a file once it is finished. */
+inline void set_output(const std::string& file, output_format format)
+{
+	detail::state& s = detail::get();
+	s.output = file;
+	s.format = format;
+	s.epoch = timer::clock::now();
+}
+
+/** Starts profiling a new load, discarding whatever an unfinished one recorded. */
+inline void start_load()
+{
+	detail::state& s = detail::get();
+	if(!s.output) {
+		return;
+	}
+
+	s.loading = true;
+	s.thread = std::this_thread::get_id();
+	s.load_start = timer::clock::now();
+	s.current = node("load");
+	s.stack.assign(1, &s.current);
+	s.events.clear();
+}
+
+/** Writes the timing tree of every finished load as JSON. */
+inline void write_json(std::ostream& out)
+{
+	const detail::state& s = detail::get();
+
+	out << "{\"loads\":[";
+	for(std::size_t i = 0; i < s.loads.size(); ++i) {
+		out << (i == 0 ? "\n" : ",\n");
+		detail::write_json_node(out, s.loads[i]);
+	}
+	out << "\n]}\n";
+}
+
+/** Writes every finished load in the Chrome trace event format. */
+inline void write_chrome_trace(std::ostream& out)
+{
+	const detail::state& s = detail::get();
+	const auto ts = [&s](timer::point p) { return std::chrono::duration_cast<microseconds>(p - s.epoch).count(); };
+
+	bool first = true;
+	out << "{\"traceEvents\":[";
+	for(std::size_t i = 0; i < s.loads.size(); ++i) {
+		out << (first ? "\n" : ",\n") << "{\"name\":";
+		detail::write_json_string(out, s.loads[i].name);
+		out << ",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << ts(s.load_starts[i])
+			<< ",\"dur\":" << s.loads[i].time.count() << '}';
+		first = false;
+	}
+
+	for(const trace_event& e : s.trace) {
+		out << (first ? "\n" : ",\n") << "{\"name\":\"" << e.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":"
+			<< ts(e.start) << ",\"dur\":" << e.duration.count() << '}';
+		first = false;
+	}
+	out << "\n]}\n";
+}
+
+/**
+ * Finishes the current load, naming its root node @a name, and rewrites the
+ * output file. Does nothing unless a load is being profiled.
+ */
+inline void finish_load(const std::string& name)
+{
+	detail::state& s = detail::get();
+	if(!s.loading) {
+		return;
+	}
+
+	s.current.name = name;
+	s.current.time = std::chrono::duration_cast<microseconds>(timer::clock::now() - s.load_start);
+	s.current.calls = 1;
+	s.loads.push_back(std::move(s.current));
+	s.load_starts.push_back(s.load_start);
+	s.current = node("load");
+	s.trace.insert(s.trace.end(), s.events.begin(), s.events.end());
+	s.events.clear();
+	s.stack.clear();
+	s.loading = false;
+
+	try {
+		filesystem::scoped_ostream out = filesystem::ostream_file(*s.output);
+		if(s.format == output_format::chrome_trace) {
+			write_chrome_trace(*out);
+		} else {
+			write_json(*out);
+		}
+	} catch(const filesystem::io_exception& e) {
+		PLAIN_LOG << "could not write the load profile to " << *s.output << ": " << e.what();
+	}
+}
+
+/** Times the enclosing scope as a phase called @a name, if a load is being profiled. */
+class scope
+{
+public:
+	explicit scope(const char* name)
+		: timer_()
+	{
+		if(!active()) {
+			return;
+		}
+
+		detail::state& s = detail::get();
+		node& n = s.stack.back()->child(name);
+		s.stack.push_back(&n);
+
+		timer_.emplace([name](const timer& t) {
+			detail::state& s = detail::get();
+			// The load may have been finished or restarted from inside the scope.
+			if(!s.loading || s.stack.size() < 2) {
+				return;
+			}
+
+			const auto duration = std::chrono::duration_cast<microseconds>(t.elapsed());
+			node& n = *s.stack.back();
+			n.time += duration;
+			++n.calls;
+			s.stack.pop_back();
+
+			if(s.events.size() < max_trace_events) {
+				s.events.push_back({name, t.start(), duration});
+			}
+		});
+	}
+
+	scope(const scope&) = delete;
+	scope& operator=(const scope&) = delete;
+
+private:
+	std::optional<timer> timer_;
+};
+
+} // namespace load_profiler
@@ -396,6 +396,10 @@ bool broke_strict() {
 	return strict_threw_;
 }
 
+void clear_broke_strict() {
+	strict_threw_ = false;
+}
+
 std::string get_timestamp(const std::time_t& t, const std::string& format) {
 	std::ostringstream ss;
 
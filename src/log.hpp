@@ -136,6 +136,8 @@ std::string list_log_domains(const std::string& filter);
 void set_strict_severity(severity severity);
 void set_strict_severity(const logger &lg);
 bool broke_strict();
+/** Forgets that the strict level was broken, so that the next unit test starts clean. */
+void clear_broke_strict();
 
 /**
  * Do the initial redirection to a log file if the logs directory is writable.
@@ -30,7 +30,9 @@
 #include "color.hpp"
 #include "display_chat_manager.hpp"
 #include "font/standard_colors.hpp"
+#include "filesystem.hpp"
 #include "formula/string_utils.hpp"
+#include "frame_profiler.hpp"
 #include "game_board.hpp"
 #include "game_config_manager.hpp"
 #include "game_end_exceptions.hpp"
@@ -1139,6 +1141,7 @@ protected:
 	void do_layers();
 	void do_fps();
 	void do_benchmark();
+	void do_profile_frames();
 	void do_save();
 	void do_save_quit();
 	void do_quit();
@@ -1241,6 +1244,9 @@ protected:
 				"layers", &console_handler::do_layers, _("Debug layers from terrain under the mouse."), "", "D");
 		register_command("fps", &console_handler::do_fps, _("Display and log fps (Frames Per Second)."));
 		register_command("benchmark", &console_handler::do_benchmark, _("Similar to the 'fps' command, but also forces everything to redraw instead of only things that have changed."));
+		register_command("profile_frames", &console_handler::do_profile_frames,
+				_("Toggle the drawing profiler overlay. With “dump”, write the recorded frames to CSV and Chrome trace files instead."),
+				_("[dump]"), "D");
 		register_command("save", &console_handler::do_save, _("Save game."));
 		register_alias("save", "w");
 		register_command("quit", &console_handler::do_quit, _("Quit game."));
@@ -1762,6 +1768,33 @@ void console_handler::do_benchmark()
 	menu_handler_.gui_->toggle_debug_flag(display::DEBUG_BENCHMARK);
 }
 
+void console_handler::do_profile_frames()
+{
+	if(get_data() != "dump") {
+		frame_profiler::set_enabled(!frame_profiler::enabled());
+		return;
+	}
+
+	if(!frame_profiler::enabled()) {
+		command_failed(_("The drawing profiler is not running."));
+		return;
+	}
+
+	const std::string base = filesystem::get_user_data_dir() + "/frame_profile";
+	{
+		filesystem::scoped_ostream csv = filesystem::ostream_file(base + ".csv");
+		frame_profiler::write_csv(*csv);
+	}
+	{
+		filesystem::scoped_ostream trace = filesystem::ostream_file(base + ".json");
+		frame_profiler::write_chrome_trace(*trace);
+	}
+
+	utils::string_map symbols;
+	symbols["file"] = base;
+	print(get_cmd(), VGETTEXT("Profile written to $file|.csv and $file|.json.", symbols));
+}
+
 void console_handler::do_save()
 {
 	menu_handler_.pc_.do_consolesave(get_data());
@@ -78,29 +78,22 @@ struct node {
 		, in(bad_search_counter)
 	{
 	}
-	node(double s, const map_location &c, const map_location &p, const map_location &dst, bool i, const teleport_map* teleports):
+	/**
+	 * @param dsth		smallest heuristic distance from a tunnel exit to @a dst;
+	 *			it only depends on the destination, so it is computed once per search.
+	 */
+	node(double s, const map_location &c, const map_location &p, const map_location &dst, bool i, const teleport_map* teleports, double dsth):
 		g(s), h(heuristic(c, dst)), t(g + h), curr(c), prev(p), in(search_counter + i)
 	{
 		if (teleports && !teleports->empty()) {
 
 			double new_srch = 1.0;
-			auto sources = teleports->get_sources();
-
-			std::set<map_location>::const_iterator it = sources.begin();
-			for(; it != sources.end(); ++it) {
-				const double tmp_srch = heuristic(c, *it);
+			for(const map_location& source : teleports->get_sources()) {
+				const double tmp_srch = heuristic(c, source);
 				if (tmp_srch < new_srch) { new_srch = tmp_srch; }
 			}
 
-			double new_dsth = 1.0;
-			auto targets = teleports->get_targets();
-
-			for(it = targets.begin(); it != targets.end(); ++it) {
-				const double tmp_dsth = heuristic(*it, dst);
-				if (tmp_dsth < new_dsth) { new_dsth = tmp_dsth; }
-			}
-
-			double new_h = new_srch + new_dsth + 1.0;
+			double new_h = new_srch + dsth + 1.0;
 			if (new_h < h) {
 				h = new_h;
 				t = g + h;
@@ -165,12 +158,23 @@ plain_route a_star_search(const map_location& src, const map_location& dst,
 	indexer index(width);
 	comp node_comp(nodes);
 
+	double teleport_dsth = 1.0;
+	if (teleports && !teleports->empty()) {
+		for(const map_location& target : teleports->get_targets()) {
+			const double tmp_dsth = heuristic(target, dst);
+			if (tmp_dsth < teleport_dsth) { teleport_dsth = tmp_dsth; }
+		}
+	}
+
 	nodes[index(dst)].g = stop_at + 1;
-	nodes[index(src)] = node(0, src, map_location::null_location(), dst, true, teleports);
+	nodes[index(src)] = node(0, src, map_location::null_location(), dst, true, teleports, teleport_dsth);
 
 	std::vector<int> pq;
 	pq.push_back(index(src));
 
+	// Reused between iterations, so that tunnels don't cause an allocation per node.
+	std::vector<map_location> locs;
+
 	while (!pq.empty()) {
 		node& n = nodes[pq.front()];
 
@@ -181,11 +185,11 @@ plain_route a_star_search(const map_location& src, const map_location& dst,
 
 		if (n.t >= nodes[index(dst)].g) break;
 
-		std::vector<map_location> locs(6);
+		locs.resize(6);
 		get_adjacent_tiles(n.curr, locs.data());
 
 		if (teleports && !teleports->empty()) {
-			auto allowed_teleports = teleports->get_adjacents(n.curr);
+			const auto allowed_teleports = teleports->get_adjacents(n.curr);
 			locs.insert(locs.end(), allowed_teleports.begin(), allowed_teleports.end());
 		}
 
@@ -204,7 +208,7 @@ plain_route a_star_search(const map_location& src, const map_location& dst,
 
 			bool in_list = next.in == search_counter + 1;
 
-			next = node(cost, loc, n.curr, dst, true, teleports);
+			next = node(cost, loc, n.curr, dst, true, teleports, teleport_dsth);
 
 			if (in_list) {
 				std::push_heap(pq.begin(), std::find(pq.begin(), pq.end(), static_cast<int>(index(loc))) + 1, node_comp);
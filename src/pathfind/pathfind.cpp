@@ -328,6 +328,8 @@ static void find_routes(
 	                                      search_counter);
 	// Begin the search at the starting location.
 	std::vector<unsigned> hexes_to_process(1, index(origin));  // Will be maintained as a heap.
+	// Reused for every hex, so that tunnels do not cause allocations.
+	std::vector<map_location> adj_locs;
 
 	while ( !hexes_to_process.empty() ) {
 		// Process the hex closest to the origin.
@@ -339,7 +341,7 @@ static void find_routes(
 		hexes_to_process.pop_back();
 
 		// Get the locations adjacent to current.
-		std::vector<map_location> adj_locs(6);
+		adj_locs.resize(6);
 		get_adjacent_tiles(cur_hex, adj_locs.data());
 
 		// Sort adjacents by on-boardness
@@ -354,7 +356,7 @@ static void find_routes(
 		adj_locs.erase(off_board_it, adj_locs.end());
 
 		if ( teleporter ) {
-			auto allowed_teleports = teleports.get_adjacents(cur_hex);
+			const auto allowed_teleports = teleports.get_adjacents(cur_hex);
 			adj_locs.insert(adj_locs.end(), allowed_teleports.begin(), allowed_teleports.end());
 		}
 		for ( int i = adj_locs.size()-1; i >= 0; --i ) {
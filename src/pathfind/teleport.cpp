@@ -170,10 +170,14 @@ teleport_map::teleport_map(
 		, const bool see_all
 		, const bool ignore_units
 		, const bool check_vision)
-	: teleport_map_()
-	, sources_()
+	: entrances_()
+	, adjacent_offsets_()
+	, adjacents_()
 	, targets_()
 {
+	// Collected per group first, then flattened into contiguous arrays below.
+	std::map<map_location, std::set<map_location>> exits_by_entrance;
+	std::set<map_location> all_targets;
 
 	for (const teleport_group& group : groups) {
 
@@ -215,56 +219,32 @@ teleport_map::teleport_map(
 			}
 		}
 
-		std::string teleport_id = group.get_teleport_id();
-		std::set<map_location>::iterator source_it = locations.first.begin();
-		for (; source_it != locations.first.end(); ++source_it ) {
-			if(teleport_map_.count(*source_it) == 0) {
-				std::set<std::string> id_set;
-				id_set.insert(teleport_id);
-				teleport_map_.emplace(*source_it, id_set);
-			} else {
-				(teleport_map_.find(*source_it)->second).insert(teleport_id);
-			}
+		for (const map_location& source : locations.first) {
+			exits_by_entrance[source].insert(locations.second.begin(), locations.second.end());
 		}
-		sources_.emplace(teleport_id, locations.first);
-		targets_.emplace(teleport_id, locations.second);
-	}
-}
-
-std::set<map_location> teleport_map::get_adjacents(map_location loc) const
-{
-	const auto iter = teleport_map_.find(loc);
-	if(iter == teleport_map_.end()) {
-		return {};
+		all_targets.insert(locations.second.begin(), locations.second.end());
 	}
 
-	std::set<map_location> res;
-	for(const std::string& key : iter->second) {
-		const auto& target = targets_.find(key)->second;
-		res.insert(target.begin(), target.end());
+	entrances_.reserve(exits_by_entrance.size());
+	adjacent_offsets_.reserve(exits_by_entrance.size() + 1);
+	adjacent_offsets_.push_back(0);
+	for (const auto& [entrance, exits] : exits_by_entrance) {
+		entrances_.push_back(entrance);
+		adjacents_.insert(adjacents_.end(), exits.begin(), exits.end());
+		adjacent_offsets_.push_back(adjacents_.size());
 	}
-
-	return res;
-}
-
-std::set<map_location> teleport_map::get_sources() const
-{
-	std::set<map_location> res;
-	for(const auto& src : sources_) {
-		res.insert(src.second.begin(), src.second.end());
-	}
-
-	return res;
+	targets_.assign(all_targets.begin(), all_targets.end());
 }
 
-std::set<map_location> teleport_map::get_targets() const
+teleport_map::location_range teleport_map::get_adjacents(map_location loc) const
 {
-	std::set<map_location> res;
-	for(const auto& tgt : targets_) {
-		res.insert(tgt.second.begin(), tgt.second.end());
+	const auto iter = std::lower_bound(entrances_.begin(), entrances_.end(), loc);
+	if(iter == entrances_.end() || *iter != loc) {
+		return location_range(adjacents_.end(), adjacents_.end());
 	}
 
-	return res;
+	const std::size_t i = iter - entrances_.begin();
+	return location_range(adjacents_.begin() + adjacent_offsets_[i], adjacents_.begin() + adjacent_offsets_[i + 1]);
 }
 
 const teleport_map get_teleport_locations(const unit &u,
@@ -18,6 +18,8 @@
 #include "config.hpp"
 #include "map/location.hpp"
 
+#include <algorithm>
+
 class team;
 class unit;
 class vconfig;
@@ -94,6 +96,34 @@ private:
 
 class teleport_map {
 public:
+	/**
+	 * A contiguous, sorted range of locations stored in a teleport_map.
+	 * It stays valid as long as the teleport_map it was obtained from.
+	 */
+	class location_range
+	{
+	public:
+		typedef std::vector<map_location>::const_iterator const_iterator;
+
+		location_range(const_iterator begin, const_iterator end)
+			: begin_(begin), end_(end) {}
+
+		const_iterator begin() const { return begin_; }
+		const_iterator end() const { return end_; }
+		bool empty() const { return begin_ == end_; }
+		std::size_t size() const { return end_ - begin_; }
+
+		/** Returns 1 if @a loc is in the range, 0 otherwise. */
+		std::size_t count(const map_location& loc) const
+		{
+			return std::binary_search(begin_, end_, loc) ? 1 : 0;
+		}
+
+	private:
+		const_iterator begin_;
+		const_iterator end_;
+	};
+
 	/*
 	 * @param teleport_groups
 	 * @param u
@@ -114,31 +144,45 @@ public:
 	 * Constructs an empty teleport map.
 	 */
 	teleport_map() :
-		teleport_map_(), sources_(), targets_() {}
+		entrances_(), adjacent_offsets_(), adjacents_(), targets_() {}
 
 	/**
+	 * Returns the hexes reachable through a tunnel from @a loc.
+	 * This does not allocate; the lookup is a binary search over the entrances.
 	 * @param loc			the map location for which we want to know the adjacent hexes
-	 * @todo what does this function actually have to do with adjacent hexes?
 	 */
-	std::set<map_location> get_adjacents(map_location loc) const;
+	location_range get_adjacents(map_location loc) const;
 
 	/** Returns the locations that are an entrance of the tunnel. */
-	std::set<map_location> get_sources() const;
+	location_range get_sources() const
+	{
+		return location_range(entrances_.begin(), entrances_.end());
+	}
 
 	/** Returns the locations that are an exit of the tunnel. */
-	std::set<map_location> get_targets() const;
+	location_range get_targets() const
+	{
+		return location_range(targets_.begin(), targets_.end());
+	}
 
 	/*
-	 * @returns whether the teleport_map does contain any defined tunnel
+	 * @returns whether the teleport_map does contain any tunnel entrance
 	 */
 	bool empty() const {
-		return sources_.empty();
+		return entrances_.empty();
 	}
 
 private:
-	std::map<map_location, std::set<std::string>> teleport_map_;
-	std::map<std::string, std::set<map_location>> sources_;
-	std::map<std::string, std::set<map_location>> targets_;
+	/** Sorted entrances of all tunnels. */
+	std::vector<map_location> entrances_;
+	/**
+	 * Entrance i leads to adjacents_[adjacent_offsets_[i]] up to (excluding)
+	 * adjacents_[adjacent_offsets_[i + 1]]; each such range is sorted.
+	 */
+	std::vector<std::size_t> adjacent_offsets_;
+	std::vector<map_location> adjacents_;
+	/** Sorted exits of all tunnels. */
+	std::vector<map_location> targets_;
 };
 
 /*
@@ -17,9 +17,13 @@
 #include "lexical_cast.hpp"
 #include "log.hpp"
 #include "persist_context.hpp"
-#include "serialization/binary_or_text.hpp"
 #include "serialization/parser.hpp"
 
+#include <set>
+#include <sstream>
+
+#define ERR_PERSIST LOG_STREAM(err, log_persist)
+
 config pack_scalar(const std::string &name, const t_string &val)
 {
 	config cfg;
@@ -31,214 +35,409 @@ static std::string get_persist_cfg_name(const std::string &name_space) {
 	return (filesystem::get_dir(filesystem::get_user_data_dir() + "/persist/") + name_space + ".cfg");
 }
 
-void persist_file_context::load()
+static std::string get_persist_store_name(const std::string &name_space) {
+	return (filesystem::get_dir(filesystem::get_user_data_dir() + "/persist/") + name_space + ".dat");
+}
+
+namespace {
+
+/*
+ * Layout of a store file, with all integers little-endian:
+ *
+ *   magic "WPST", u32 version, u32 number of values
+ *   for each value: u32 key length, key, u64 offset of the value, u32 value length
+ *   the values, as WML text
+ */
+const char store_magic[4] = {'W', 'P', 'S', 'T'};
+const uint32_t store_version = 1;
+
+void write_uint(std::ostream &out, uint64_t value, unsigned bytes)
 {
-	std::string cfg_name = get_persist_cfg_name(namespace_.root_);
-	if (filesystem::file_exists(cfg_name) && !filesystem::is_directory(cfg_name)) {
-		filesystem::scoped_istream file_stream = filesystem::istream_file(cfg_name);
-		if (!(file_stream->fail())) {
-			try {
-				read(cfg_,*file_stream);
-			} catch (const config::error &err) {
-				LOG_PERSIST << err.message;
-			}
+	for (unsigned i = 0; i < bytes; ++i) {
+		out.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+	}
+}
+
+uint64_t read_uint(std::istream &in, unsigned bytes)
+{
+	uint64_t value = 0;
+	for (unsigned i = 0; i < bytes; ++i) {
+		value |= static_cast<uint64_t>(static_cast<unsigned char>(in.get())) << (8 * i);
+	}
+	return value;
+}
+
+std::string read_bytes(std::istream &in, std::size_t length)
+{
+	std::string bytes(length, '\0');
+	in.read(bytes.data(), length);
+	return bytes;
+}
+
+} // anonymous namespace
+
+persist_store::persist_store(const std::string &filename)
+	: filename_(filename)
+	, index_()
+	, cache_()
+	, pending_()
+	, writable_(true)
+{
+	read_index();
+}
+
+void persist_store::read_index()
+{
+	index_.clear();
+	if (!exists()) {
+		return;
+	}
+
+	filesystem::scoped_istream in = filesystem::istream_file(filename_);
+	if (read_bytes(*in, sizeof(store_magic)) != std::string(store_magic, sizeof(store_magic))
+		|| read_uint(*in, 4) != store_version)
+	{
+		ERR_PERSIST << "'" << filename_ << "' is not a persistent variable file of a known version, it will not be written to";
+		writable_ = false;
+		return;
+	}
+
+	const uint64_t size = filesystem::file_size(filename_);
+	const uint32_t count = read_uint(*in, 4);
+	for (uint32_t i = 0; i < count && in->good(); ++i) {
+		const uint32_t key_length = read_uint(*in, 4);
+		if (key_length > size) {
+			in->setstate(std::ios_base::failbit);
+			break;
 		}
+
+		const std::string key = read_bytes(*in, key_length);
+		record& rec = index_[key];
+		rec.offset = read_uint(*in, 8);
+		rec.length = read_uint(*in, 4);
+	}
+
+	if (!in->good()) {
+		ERR_PERSIST << "The index of '" << filename_ << "' is truncated, it will not be written to";
+		index_.clear();
+		writable_ = false;
 	}
 }
 
-persist_file_context::persist_file_context(const std::string &name_space)
-	: persist_context(name_space)
+bool persist_store::exists() const
 {
-	load();
+	return filesystem::file_exists(filename_) && !filesystem::is_directory(filename_);
 }
 
-bool persist_file_context::clear_var(const std::string &global, bool immediate)
+const config *persist_store::get(const std::string &key) const
+{
+	const change_map::const_iterator change = pending_.find(key);
+	if (change != pending_.end()) {
+		return change->second ? &*change->second : nullptr;
+	}
+
+	const auto cached = cache_.find(key);
+	if (cached != cache_.end()) {
+		return &cached->second;
+	}
+
+	const auto rec = index_.find(key);
+	if (rec == index_.end()) {
+		return nullptr;
+	}
+
+	filesystem::scoped_istream in = filesystem::istream_file(filename_);
+	in->seekg(rec->second.offset);
+	const std::string bytes = read_bytes(*in, rec->second.length);
+	if (in->fail()) {
+		ERR_PERSIST << "Could not read '" << key << "' from '" << filename_ << "'";
+		return nullptr;
+	}
+
+	config &value = cache_[key];
+	try {
+		read(value, bytes);
+	} catch (const config::error &err) {
+		ERR_PERSIST << "Could not read '" << key << "' from '" << filename_ << "': " << err.message;
+	}
+	return &value;
+}
+
+void persist_store::set(const std::string &key, const config &value)
+{
+	pending_[key] = value;
+}
+
+void persist_store::remove(const std::string &key)
+{
+	pending_[key] = std::nullopt;
+}
+
+bool persist_store::commit()
+{
+	if (pending_.empty()) {
+		return true;
+	}
+
+	const bool success = write(pending_);
+	if (success) {
+		pending_.clear();
+	}
+	return success;
+}
+
+bool persist_store::commit(const std::string &key)
+{
+	const change_map::iterator change = pending_.find(key);
+	if (change == pending_.end()) {
+		return true;
+	}
+
+	const bool success = write(change_map{*change});
+	if (success) {
+		pending_.erase(change);
+	}
+	return success;
+}
+
+void persist_store::discard()
+{
+	pending_.clear();
+}
+
+bool persist_store::write(const change_map &changes)
 {
-	config bak;
-	config bactive;
-	if (immediate) {
-		bak = cfg_;
-		config *node = get_node(bak, namespace_);
-		if (node)
-			bactive = node->child_or_add("variables");
-		load();
-	}
-	config *active = get_node(cfg_, namespace_);
-	if (active == nullptr)
+	// Rewriting a file whose index could not be read would lose its values.
+	if (!writable_) {
+		ERR_PERSIST << "Not writing to '" << filename_ << "', it could not be read";
 		return false;
+	}
 
-	bool ret = active->has_child("variables");
-	if (ret) {
-		config &cfg = active->mandatory_child("variables");
-		bool exists = cfg.has_attribute(global);
-		if (!exists) {
-			if (cfg.has_child(global)) {
-				exists = true;
-				std::string::const_iterator index_start = std::find(global.begin(),global.end(),'[');
-				if (index_start != global.end())
-				{
-					const std::string::const_iterator index_end = std::find(global.begin(),global.end(),']');
-					const std::string index_str(index_start+1,index_end);
-					std::size_t index = static_cast<std::size_t>(lexical_cast_default<int>(index_str));
-					cfg.remove_child(global,index);
-					if (immediate) bactive.remove_child(global,index);
-				} else {
-					cfg.clear_children(global);
-					if (immediate) bactive.clear_children(global);
-				}
-			}
+	// The new file holds the unchanged values of the old one, copied as they
+	// are, followed by the changed ones.
+	std::map<std::string, record> copied;
+	for (const auto &[key, rec] : index_) {
+		if (changes.count(key) == 0)
+			copied.emplace(key, rec);
+	}
+
+	std::map<std::string, std::string> written;
+	for (const auto &[key, value] : changes) {
+		if (value) {
+			std::ostringstream out;
+			::write(out, *value);
+			written.emplace(key, out.str());
 		}
-		if (exists) {
-			cfg.remove_attribute(global);
-			if (immediate) bactive.remove_attribute(global);
-			if (cfg.empty()) {
-				active->clear_children("variables");
-				active->remove_attribute("variables");
-				name_space working = namespace_;
-				while ((active->empty()) && (!working.lineage_.empty())) {
-					name_space prev = working.prev();
-					active = get_node(cfg_, prev);
-					active->clear_children(working.node_);
-					if (active->has_child("variables") && active->mandatory_child("variables").empty()) {
-						active->clear_children("variables");
-						active->remove_attribute("variables");
-					}
-					working = prev;
-				}
+	}
+
+	std::map<std::string, record> new_index;
+	if (copied.empty() && written.empty()) {
+		if (exists() && !filesystem::delete_file(filename_)) {
+			ERR_PERSIST << "Could not delete '" << filename_ << "'";
+			return false;
+		}
+	} else {
+		uint64_t offset = sizeof(store_magic) + 4 + 4;
+		for (const auto &[key, rec] : copied)
+			offset += 4 + key.size() + 8 + 4;
+		for (const auto &[key, value] : written)
+			offset += 4 + key.size() + 8 + 4;
+
+		for (const auto &[key, rec] : copied) {
+			new_index[key] = {offset, rec.length};
+			offset += rec.length;
+		}
+		for (const auto &[key, value] : written) {
+			new_index[key] = {offset, static_cast<uint32_t>(value.size())};
+			offset += value.size();
+		}
+
+		const std::string temp_name = filename_ + ".new";
+		{
+			filesystem::scoped_ostream out = filesystem::ostream_file(temp_name);
+			out->write(store_magic, sizeof(store_magic));
+			write_uint(*out, store_version, 4);
+			write_uint(*out, new_index.size(), 4);
+			for (const auto &[key, rec] : new_index) {
+				write_uint(*out, key.size(), 4);
+				out->write(key.data(), key.size());
+				write_uint(*out, rec.offset, 8);
+				write_uint(*out, rec.length, 4);
 			}
 
-			if (!in_transaction_)
-				ret = save_context();
-			else if (immediate) {
-				ret = save_context();
-				cfg_ = bak;
-				active = get_node(cfg_, namespace_);
-				if (active != nullptr) {
-					active->clear_children("variables");
-					active->remove_attribute("variables");
-					if (!bactive.empty())
-						active->add_child("variables",bactive);
+			if (!copied.empty()) {
+				filesystem::scoped_istream in = filesystem::istream_file(filename_);
+				for (const auto &[key, rec] : copied) {
+					in->seekg(rec.offset);
+					out->write(read_bytes(*in, rec.length).data(), rec.length);
 				}
-			} else {
-				ret = true;
-			}
-		} else {
-			if (immediate) {
-				cfg_ = bak;
-				active = get_node(cfg_, namespace_);
-				if (active != nullptr) {
-					active->clear_children("variables");
-					active->remove_attribute("variables");
-					if (!bactive.empty())
-						active->add_child("variables", bactive);
+				if (in->fail()) {
+					ERR_PERSIST << "Could not read '" << filename_ << "'";
+					return false;
 				}
 			}
-			ret = exists;
-		}
-	}
 
-	// TODO: figure out when this is the case and adjust the next loop
-	//       condition accordingly. -- shadowm
-	assert(active);
+			for (const auto &[key, value] : written) {
+				out->write(value.data(), value.size());
+			}
 
-	while (active && active->empty() && !namespace_.lineage_.empty()) {
-		name_space prev = namespace_.prev();
-		active = get_node(cfg_, prev);
-		if (active == nullptr) {
-			break;
+			out->flush();
+			if (out->fail()) {
+				ERR_PERSIST << "Could not write '" << temp_name << "'";
+				return false;
+			}
 		}
-		active->clear_children(namespace_.node_);
-		if (active->has_child("variables") && active->mandatory_child("variables").empty()) {
-			active->clear_children("variables");
-			active->remove_attribute("variables");
+
+		if (!filesystem::rename_file(temp_name, filename_)) {
+			return false;
 		}
-		namespace_ = prev;
 	}
-	return ret;
+
+	index_ = std::move(new_index);
+	for (const auto &[key, value] : changes) {
+		if (value)
+			cache_[key] = *value;
+		else
+			cache_.erase(key);
+	}
+	return true;
 }
 
-config persist_file_context::get_var(const std::string &global) const
+/**
+ * Adds the variables of @a node and its descendants in a persistence file of
+ * the old format to @a store. A namespace only ever used the first child of a
+ * given name, so the others are skipped.
+ */
+static void import_legacy_node(persist_store &store, const config &node, const std::string &path)
 {
-	config ret;
-	const config *active = get_node(cfg_, namespace_);
-	if (active && (active->has_child("variables"))) {
-		const config &cfg = active->mandatory_child("variables");
-		std::size_t arrsize = cfg.child_count(global);
-		if (arrsize > 0) {
-			for (std::size_t i = 0; i < arrsize; i++)
-				ret.add_child(global, cfg.mandatory_child(global,i));
-		} else {
-			ret = pack_scalar(global,cfg[global]);
+	if (auto vars = node.optional_child("variables")) {
+		for (const auto &[name, value] : vars->attribute_range()) {
+			store.set(path + ":" + name, pack_scalar(name, value));
 		}
-	} else {
-		ret = pack_scalar(global,"");
+
+		// Arrays override scalars of the same name, as they did in get_var().
+		std::map<std::string, config> arrays;
+		for (const config::any_child child : vars->all_children_range()) {
+			arrays[child.key].add_child(child.key, child.cfg);
+		}
+		for (const auto &[name, array] : arrays) {
+			store.set(path + ":" + name, array);
+		}
+	}
+
+	std::set<std::string> visited;
+	for (const config::any_child child : node.all_children_range()) {
+		if (child.key == "variables" || !visited.insert(child.key).second)
+			continue;
+		import_legacy_node(store, child.cfg, path.empty() ? child.key : path + "." + child.key);
 	}
-	return ret;
 }
-bool persist_file_context::save_context() {
-	bool success = false;
+
+void persist_file_context::import_legacy_file()
+{
+	if (store_.exists())
+		return;
 
 	std::string cfg_name = get_persist_cfg_name(namespace_.root_);
-	if (!cfg_name.empty()) {
-		if (cfg_.empty()) {
-			success = filesystem::delete_file(cfg_name);
-		} else {
-			filesystem::scoped_ostream out = filesystem::ostream_file(cfg_name);
-			if (!out->fail())
-			{
-				config_writer writer(*out,false);
-				try {
-					writer.write(cfg_);
-					success = true;
-				} catch(config::error &err) {
-					LOG_PERSIST << err.message;
-					success = false;
-				}
-			}
+	if (filesystem::file_exists(cfg_name) && !filesystem::is_directory(cfg_name)) {
+		config cfg;
+		filesystem::scoped_istream file_stream = filesystem::istream_file(cfg_name);
+		if (file_stream->fail())
+			return;
+		try {
+			read(cfg,*file_stream);
+		} catch (const config::error &err) {
+			LOG_PERSIST << err.message;
+			return;
+		}
+
+		// The old file is left in place, so that older versions still find
+		// it. It is not read again once the new one exists.
+		import_legacy_node(store_, cfg, "");
+		if (store_.commit()) {
+			LOG_PERSIST << "Converted '" << cfg_name << "' to the indexed format";
 		}
 	}
-	return success;
 }
-bool persist_file_context::set_var(const std::string &global,const config &val, bool immediate)
+
+persist_file_context::persist_file_context(const std::string &name_space)
+	: persist_context(name_space)
+	, store_(get_persist_store_name(namespace_.root_))
+{
+	import_legacy_file();
+}
+
+std::string persist_file_context::var_key(const std::string &global) const
+{
+	// Namespaces cannot contain ':', so this cannot mix up two variables.
+	return namespace_.descendants_ + ":" + global;
+}
+
+bool persist_file_context::commit_var(const std::string &key, bool immediate)
+{
+	if (!in_transaction_)
+		return store_.commit();
+	else if (immediate)
+		return store_.commit(key);
+	else
+		return true;
+}
+
+bool persist_file_context::clear_var(const std::string &global, bool immediate)
 {
-	config bak;
-	config bactive;
-	if (immediate) {
-		bak = cfg_;
-		bactive = get_node(bak, namespace_, true)->child_or_add("variables");
-		load();
+	// "name[N]" only removes the Nth element of the array "name".
+	const std::size_t index_start = global.find('[');
+	if (index_start != std::string::npos) {
+		const std::string name = global.substr(0, index_start);
+		const std::size_t index_end = global.find(']', index_start);
+		const std::string index_str = global.substr(index_start + 1, index_end - index_start - 1);
+		const int index = lexical_cast_default<int>(index_str, -1);
+
+		const std::string key = var_key(name);
+		const config *array = store_.get(key);
+		if (array == nullptr || index < 0 || static_cast<std::size_t>(index) >= array->child_count(name))
+			return false;
+
+		config remaining = *array;
+		remaining.remove_child(name, index);
+		if (remaining.has_child(name))
+			store_.set(key, remaining);
+		else
+			store_.remove(key);
+		return commit_var(key, immediate);
 	}
 
-	config *active = get_node(cfg_, namespace_, true);
-	config &cfg = active->child_or_add("variables");
+	const std::string key = var_key(global);
+	if (store_.get(key) == nullptr)
+		return false;
+
+	store_.remove(key);
+	return commit_var(key, immediate);
+}
+
+config persist_file_context::get_var(const std::string &global) const
+{
+	const config *value = store_.get(var_key(global));
+	return value ? *value : pack_scalar(global,"");
+}
+
+bool persist_file_context::set_var(const std::string &global,const config &val, bool immediate)
+{
+	if (val.has_attribute(global) && val[global].empty())
+		return clear_var(global,immediate);
+
+	const std::string key = var_key(global);
 	if (val.has_attribute(global)) {
-		if (val[global].empty()) {
-			clear_var(global,immediate);
-		} else {
-			cfg[global] = val[global];
-			if (immediate) bactive[global] = val[global];
-		}
+		store_.set(key, pack_scalar(global, val[global]));
+	} else if (val.has_child(global)) {
+		config array;
+		for (const config &child : val.child_range(global))
+			array.add_child(global, child);
+		store_.set(key, array);
 	} else {
-		cfg.clear_children(global);
-		cfg.append(val);
-		if (immediate) {
-			bactive.clear_children(global);
-			bactive.append(val);
-		}
+		store_.remove(key);
 	}
-//	dirty_ = true;
-	if (!in_transaction_)
-		return save_context();
-	else if (immediate) {
-		bool ret = save_context();
-		cfg_ = bak;
-		active = get_node(cfg_, namespace_, true);
-		active->clear_children("variables");
-		active->remove_attribute("variables");
-		active->add_child("variables",bactive);
-		return ret;
-	} else
-		return true;
+	return commit_var(key, immediate);
 }
 
 void persist_context::set_node(const std::string &name) {
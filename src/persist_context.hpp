@@ -17,6 +17,11 @@
 
 #include "config.hpp"
 #include "log.hpp"
+
+#include <cstdint>
+#include <map>
+#include <optional>
+
 static lg::log_domain log_persist("engine/persistence");
 
 #define LOG_PERSIST LOG_STREAM(info, log_persist)
@@ -100,51 +105,22 @@ public:
 		}
 	};
 protected:
-	config cfg_;
 	name_space namespace_;
 	bool valid_;
 	bool in_transaction_;
 
 	persist_context()
-		: cfg_()
-		, namespace_()
+		: namespace_()
 		, valid_(false)
 		, in_transaction_(false)
 	{}
 
 	persist_context(const std::string &name_space)
-		: cfg_()
-		, namespace_(name_space,true)
+		: namespace_(name_space,true)
 		, valid_(namespace_.valid())
 		, in_transaction_(false)
 	{}
 
-	config *get_node(config &cfg, name_space &ns, bool force = false) {
-		name_space next = ns.next();
-		if (next) {
-			if (force)
-				return get_node(cfg.child_or_add(next.root_), next, true);
-			else if (cfg.has_child(next.root_))
-				return get_node(cfg.mandatory_child(next.root_), next);
-			else
-				return nullptr;
-		}
-		else
-			return &cfg;
-	}
-
-	const config *get_node(const config &cfg, const name_space &ns) const {
-		name_space next = ns.next();
-		if (next) {
-			if (cfg.has_child(next.root_))
-				return get_node(cfg.mandatory_child(next.root_), next);
-			else
-				return nullptr;
-		}
-		else
-			return &cfg;
-	}
-
 public:
 	virtual bool clear_var(const std::string &, bool immediate = false) = 0;
 	virtual config get_var(const std::string &) const = 0;
@@ -161,11 +137,67 @@ public:
 	operator bool() const { return valid_; }
 };
 
+/**
+ * A file of persistent variables, which are read and written one at a time.
+ *
+ * The file starts with an index giving the position of every value, and only
+ * the index is read when the store is opened. A value is read and parsed the
+ * first time it is needed, and is cached from then on.
+ *
+ * Changes are kept in memory until they are committed. A commit writes a new
+ * file next to the old one and then renames it over the old one, so a write
+ * that is interrupted never loses the previous contents. The unchanged values
+ * are copied as raw bytes, without being parsed again.
+ *
+ * A file that is not in a known format is never written to.
+ */
+class persist_store {
+public:
+	explicit persist_store(const std::string &filename);
+
+	/** The value stored under @a key, or nullptr if there is none. */
+	const config *get(const std::string &key) const;
+	void set(const std::string &key, const config &value);
+	void remove(const std::string &key);
+
+	/** Writes all pending changes to the file. */
+	bool commit();
+	/** Writes the pending change to @a key only, and keeps the others pending. */
+	bool commit(const std::string &key);
+	/** Drops all pending changes. */
+	void discard();
+
+	/** Whether the file exists. */
+	bool exists() const;
+
+private:
+	struct record {
+		uint64_t offset;
+		uint32_t length;
+	};
+
+	/** Changes to write. A key without a value is removed. */
+	typedef std::map<std::string, std::optional<config>> change_map;
+
+	void read_index();
+	bool write(const change_map &changes);
+
+	std::string filename_;
+	std::map<std::string, record> index_;
+	/** Values read from the file, or written to it by this store. */
+	mutable std::map<std::string, config> cache_;
+	change_map pending_;
+	/** False if the file exists but its index could not be read, so rewriting it would lose its values. */
+	bool writable_;
+};
+
 class persist_file_context : public persist_context {
 private:
-	void load();
-	void init();
-	bool save_context();
+	void import_legacy_file();
+	std::string var_key(const std::string &global) const;
+	bool commit_var(const std::string &key, bool immediate);
+
+	persist_store store_;
 
 public:
 	persist_file_context(const std::string &name_space);
@@ -183,13 +215,13 @@ public:
 		if (!in_transaction_)
 			return false;
 		in_transaction_ = false;
-		save_context();
+		store_.commit();
 		return true;
 	}
 	bool cancel_transaction () {
 		if (!in_transaction_)
 			return false;
-		load();
+		store_.discard();
 		in_transaction_ = false;
 		return true;
 	}
@@ -21,6 +21,7 @@
 #include "picture.hpp"
 
 #include "filesystem.hpp"
+#include "frame_profiler.hpp"
 #include "game_config.hpp"
 #include "image_modifications.hpp"
 #include "log.hpp"
@@ -35,6 +36,7 @@
 #include <boost/algorithm/string.hpp>
 
 #include <array>
+#include <mutex>
 #include <set>
 
 static lg::log_domain log_image("image");
@@ -183,6 +185,9 @@ std::map<std::string, bool> image_existence_map;
 // directories where we already cached file existence
 std::set<std::string> precached_dirs;
 
+// guards the two above, the terrain builder may check images on another thread
+std::mutex image_existence_mutex;
+
 int red_adjust = 0, green_adjust = 0, blue_adjust = 0;
 
 const std::string data_uri_prefix = "data:";
@@ -227,6 +232,8 @@ void flush_cache()
 	textures_.clear();
 	textures_hexed_.clear();
 	texture_tod_colored_.clear();
+
+	std::scoped_lock lock(image_existence_mutex);
 	image_existence_map.clear();
 	precached_dirs.clear();
 }
@@ -696,6 +703,8 @@ surface get_surface(
 
 	DBG_IMG << "surface cache [" << type << "] miss: " << i_locator;
 
+	const frame_profiler::scope profiler_scope(frame_profiler::section::image_cache_miss);
+
 	// not cached, generate it
 	switch(type) {
 	case UNSCALED:
@@ -858,6 +867,8 @@ bool exists(const image::locator& i_locator)
 		return false;
 	}
 
+	std::scoped_lock lock(image_existence_mutex);
+
 	// The insertion will fail if there is already an element in the cache
 	// and this will point to the existing element.
 	auto [iter, success] = image_existence_map.emplace(i_locator.get_filename(), false);
@@ -905,6 +916,7 @@ void precache_file_existence(const std::string& subdir)
 {
 	const std::vector<std::string>& paths = filesystem::get_binary_paths("images");
 
+	std::scoped_lock lock(image_existence_mutex);
 	for(const auto& p : paths) {
 		precache_file_existence_internal(p, subdir);
 	}
@@ -912,6 +924,7 @@ void precache_file_existence(const std::string& subdir)
 
 bool precached_file_exists(const std::string& file)
 {
+	std::scoped_lock lock(image_existence_mutex);
 	const auto b = image_existence_map.find(file);
 	if(b != image_existence_map.end()) {
 		return b->second;
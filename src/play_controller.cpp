@@ -39,6 +39,7 @@
 #include "gui/dialogs/transient_message.hpp"
 #include "hotkey/command_executor.hpp"
 #include "hotkey/hotkey_handler.hpp"
+#include "load_profiler.hpp"
 #include "log.hpp"
 #include "map/label.hpp"
 #include "pathfind/teleport.hpp"
@@ -56,6 +57,7 @@
 #include "soundsource.hpp"
 #include "statistics.hpp"
 #include "synced_context.hpp"
+#include "terrain/builder.hpp"
 #include "units/types.hpp"
 #include "units/unit.hpp"
 #include "utils/general.hpp"
@@ -63,6 +65,8 @@
 #include "whiteboard/manager.hpp"
 
 #include <functional>
+#include <future>
+#include <optional>
 
 static lg::log_domain log_aitesting("ai/testing");
 #define LOG_AIT LOG_STREAM(info, log_aitesting)
@@ -210,7 +214,17 @@ void play_controller::init(const config& level)
 	gui2::dialogs::loading_screen::display([this, &level]() {
 		gui2::dialogs::loading_screen::progress(loading_stage::load_level);
 
+		// Parsing the global terrain rules only needs the game config, so it can
+		// overlap with setting up the game state. It has to be done before the
+		// display is created, since that builds the terrain.
+		std::future<void> terrain_rules;
+		if(terrain_builder::global_rules_pending()) {
+			terrain_rules = std::async(std::launch::async, &terrain_builder::prepare_global_rules);
+		}
+
 		LOG_NG << "initializing game_state..." << (SDL_GetTicks() - ticks());
+		std::optional<load_profiler::scope> profile_phase;
+		profile_phase.emplace("game_state");
 		gamestate_.reset(new game_state(level, *this));
 
 		resources::gameboard = &gamestate().board_;
@@ -226,11 +240,13 @@ void play_controller::init(const config& level)
 		resources::tunnels = gamestate().pathfind_manager_.get();
 
 		LOG_NG << "initializing whiteboard..." << (SDL_GetTicks() - ticks());
+		profile_phase.emplace("whiteboard");
 		gui2::dialogs::loading_screen::progress(loading_stage::init_whiteboard);
 		whiteboard_manager_.reset(new wb::manager());
 		resources::whiteboard = whiteboard_manager_;
 
 		LOG_NG << "loading units..." << (SDL_GetTicks() - ticks());
+		profile_phase.emplace("encounter content");
 		gui2::dialogs::loading_screen::progress(loading_stage::load_units);
 		preferences::encounter_all_content(gamestate().board_);
 
@@ -238,8 +254,14 @@ void play_controller::init(const config& level)
 		gui2::dialogs::loading_screen::progress(loading_stage::init_theme);
 
 		LOG_NG << "building terrain rules... " << (SDL_GetTicks() - ticks());
+		profile_phase.emplace("display");
 		gui2::dialogs::loading_screen::progress(loading_stage::build_terrain);
 
+		if(terrain_rules.valid()) {
+			load_profiler::scope profile_join("terrain rules join");
+			terrain_rules.get();
+		}
+
 		gui_.reset(new game_display(gamestate().board_, whiteboard_manager_, *gamestate().reports_, theme(), level));
 		map_start_ = map_location(level.child_or_empty("display").child_or_empty("location"));
 		if(start_faded_) {
@@ -265,6 +287,7 @@ void play_controller::init(const config& level)
 		LOG_NG << "done initializing display... " << (SDL_GetTicks() - ticks());
 
 		LOG_NG << "building gamestate to gui and whiteboard... " << (SDL_GetTicks() - ticks());
+		profile_phase.emplace("managers and lua");
 		// This *needs* to be created before the show_intro and show_map_scene
 		// as that functions use the manager state_of_game
 		// Has to be done before registering any events!
@@ -277,6 +300,8 @@ void play_controller::init(const config& level)
 		gamestate().gamedata_.set_phase(game_data::PRELOAD);
 		gamestate().lua_kernel_->load_game(level);
 
+		profile_phase.reset();
+
 		plugins_context_.reset(new plugins_context("Game"));
 		plugins_context_->set_callback("save_game", [this](const config& cfg) { save_game_auto(cfg["filename"]); }, true);
 		plugins_context_->set_callback("save_replay", [this](const config& cfg) { save_replay_auto(cfg["filename"]); }, true);
@@ -339,6 +364,7 @@ void play_controller::init_managers()
 void play_controller::fire_preload()
 {
 	// Run initialization scripts, even if loading from a snapshot.
+	load_profiler::scope profile("preload event");
 	gamestate().gamedata_.get_variable("turn_number") = static_cast<int>(turn());
 	pump().fire("preload");
 	gamestate().lua_kernel_->preload_finished();
@@ -346,6 +372,8 @@ void play_controller::fire_preload()
 
 void play_controller::fire_prestart()
 {
+	load_profiler::scope profile("prestart event");
+
 	// pre-start events must be executed before any GUI operation,
 	// as those may cause the display to be refreshed.
 	gamestate().gamedata_.set_phase(game_data::PRESTART);
@@ -371,6 +399,7 @@ void play_controller::refresh_objectives() const
 
 void play_controller::fire_start()
 {
+	load_profiler::scope profile("start event");
 	gamestate().gamedata_.set_phase(game_data::START);
 	pump().fire("start");
 
@@ -33,6 +33,7 @@
 #include "gui/dialogs/story_viewer.hpp"
 #include "gui/dialogs/transient_message.hpp"
 #include "hotkey/hotkey_handler_sp.hpp"
+#include "load_profiler.hpp"
 #include "log.hpp"
 #include "map/label.hpp"
 #include "map/map.hpp"
@@ -170,6 +171,8 @@ void playsingle_controller::play_scenario_init(const config& level)
 	gamestate().gamedata_.set_phase(game_data::read_phase(level));
 
 	start_game();
+	load_profiler::finish_load(level["id"].str());
+
 	gamestate_->player_number_ = skip_empty_sides(gamestate_->player_number_).side_num;
 
 	if(!get_teams().empty()) {
@@ -20,6 +20,7 @@
 #include "font/text_formatting.hpp"
 #include "formatter.hpp"
 #include "formula/string_utils.hpp"
+#include "frame_profiler.hpp"
 #include "preferences/game.hpp"
 #include "gettext.hpp"
 #include "language.hpp"
@@ -36,6 +37,7 @@
 #include "units/helper.hpp"
 #include "units/types.hpp"
 #include "units/unit_alignments.hpp"
+#include "utils/optimer.hpp"
 #include "whiteboard/manager.hpp"
 
 #include <ctime>
@@ -107,22 +109,40 @@ static const time_of_day get_visible_time_of_day_at(const reports::context& rc,
 	}
 }
 
-typedef std::map<std::string, reports::generator_function> static_report_generators;
+struct static_report_generator
+{
+	reports::generator_function generate;
+	unsigned dependencies;
+};
+
+typedef std::map<std::string, static_report_generator> static_report_generators;
 static static_report_generators static_generators;
 
 struct report_generator_helper
 {
-	report_generator_helper(const char *name, reports::generator_function g)
+	report_generator_helper(const char *name, reports::generator_function g, unsigned deps)
 	{
-		static_generators.insert(static_report_generators::value_type(name, g));
+		static_generators.insert(static_report_generators::value_type(name, {g, deps}));
 	}
 };
 
-#define REPORT_GENERATOR(n, cn) \
+/**
+ * Defines a report generator. @a deps is the set of reports::dependency bits
+ * naming the inputs the report reads; it is only regenerated when one of them
+ * has changed.
+ */
+#define REPORT_GENERATOR(n, deps, cn) \
 	static config report_##n(const reports::context& cn); \
-	static report_generator_helper reg_gen_##n(#n, &report_##n); \
+	static report_generator_helper reg_gen_##n(#n, &report_##n, deps); \
 	static config report_##n(const reports::context& cn)
 
+/** Inputs of the reports describing the unit under the mouse. */
+static const unsigned DISPLAYED_UNIT_DEPS = reports::DEP_MOUSEOVER | reports::DEP_UNITS | reports::DEP_VIEWING_TEAM;
+/** Inputs of the reports describing the selected unit. */
+static const unsigned SELECTED_UNIT_DEPS = reports::DEP_SELECTED_UNIT | reports::DEP_UNITS | reports::DEP_VIEWING_TEAM;
+/** Inputs of the reports comparing the selected unit with the one under the mouse. */
+static const unsigned BOTH_UNITS_DEPS = DISPLAYED_UNIT_DEPS | SELECTED_UNIT_DEPS;
+
 static char const *naps = "</span>";
 
 static const unit *get_visible_unit(const reports::context& rc)
@@ -171,12 +191,12 @@ static config unit_name(const unit *u)
 	return text_report(str.str(), tooltip.str());
 }
 
-REPORT_GENERATOR(unit_name, rc)
+REPORT_GENERATOR(unit_name, DISPLAYED_UNIT_DEPS, rc)
 {
 	const unit *u = get_visible_unit(rc);
 	return unit_name(u);
 }
-REPORT_GENERATOR(selected_unit_name, rc)
+REPORT_GENERATOR(selected_unit_name, SELECTED_UNIT_DEPS, rc)
 {
 	const unit *u = get_selected_unit(rc);
 	return unit_name(u);
@@ -198,12 +218,12 @@ static config unit_type(const unit* u)
 	}
 	return text_report(str.str(), tooltip.str(), has_variations_prefix + "unit_" + u->type_id());
 }
-REPORT_GENERATOR(unit_type, rc)
+REPORT_GENERATOR(unit_type, DISPLAYED_UNIT_DEPS, rc)
 {
 	const unit *u = get_visible_unit(rc);
 	return unit_type(u);
 }
-REPORT_GENERATOR(selected_unit_type, rc)
+REPORT_GENERATOR(selected_unit_type, SELECTED_UNIT_DEPS, rc)
 {
 	const unit *u = get_selected_unit(rc);
 	return unit_type(u);
@@ -217,12 +237,12 @@ static config unit_race(const unit* u)
 	tooltip << _("Race: ") << "<b>" << u->race()->name(u->gender()) << "</b>";
 	return text_report(str.str(), tooltip.str(), "..race_" + u->race()->id());
 }
-REPORT_GENERATOR(unit_race, rc)
+REPORT_GENERATOR(unit_race, DISPLAYED_UNIT_DEPS, rc)
 {
 	const unit *u = get_visible_unit(rc);
 	return unit_race(u);
 }
-REPORT_GENERATOR(selected_unit_race, rc)
+REPORT_GENERATOR(selected_unit_race, SELECTED_UNIT_DEPS, rc)
 {
 	const unit *u = get_selected_unit(rc);
 	return unit_race(u);
@@ -259,12 +279,12 @@ static config unit_side(const reports::context& rc, const unit* u)
 	add_text(report, text.str(), tooltip, "");
 	return report;
 }
-REPORT_GENERATOR(unit_side, rc)
+REPORT_GENERATOR(unit_side, DISPLAYED_UNIT_DEPS, rc)
 {
 	const unit *u = get_visible_unit(rc);
 	return unit_side(rc,u);
 }
-REPORT_GENERATOR(selected_unit_side, rc)
+REPORT_GENERATOR(selected_unit_side, SELECTED_UNIT_DEPS, rc)
 {
 	const unit *u = get_selected_unit(rc);
 	return unit_side(rc, u);
@@ -275,18 +295,18 @@ static config unit_level(const unit* u)
 	if (!u) return config();
 	return text_report(std::to_string(u->level()), unit_helper::unit_level_tooltip(*u));
 }
-REPORT_GENERATOR(unit_level, rc)
+REPORT_GENERATOR(unit_level, DISPLAYED_UNIT_DEPS, rc)
 {
 	const unit *u = get_visible_unit(rc);
 	return unit_level(u);
 }
-REPORT_GENERATOR(selected_unit_level, rc)
+REPORT_GENERATOR(selected_unit_level, SELECTED_UNIT_DEPS, rc)
 {
 	const unit *u = get_selected_unit(rc);
 	return unit_level(u);
 }
 
-REPORT_GENERATOR(unit_amla, rc)
+REPORT_GENERATOR(unit_amla, DISPLAYED_UNIT_DEPS, rc)
 {
 	const unit *u = get_visible_unit(rc);
 	if (!u) return config();
@@ -317,12 +337,12 @@ static config unit_traits(const unit* u)
 	}
 	return res;
 }
-REPORT_GENERATOR(unit_traits, rc)
+REPORT_GENERATOR(unit_traits, DISPLAYED_UNIT_DEPS, rc)
 {
 	const unit *u = get_visible_unit(rc);
 	return unit_traits(u);
 }
-REPORT_GENERATOR(selected_unit_traits, rc)
+REPORT_GENERATOR(selected_unit_traits, SELECTED_UNIT_DEPS, rc)
 {
 	const unit *u = get_selected_unit(rc);
 	return unit_traits(u);
@@ -359,12 +379,12 @@ static config unit_status(const reports::context& rc, const unit* u)
 	}
 	return res;
 }
-REPORT_GENERATOR(unit_status,rc)
+REPORT_GENERATOR(unit_status, DISPLAYED_UNIT_DEPS, rc)
 {
 	const unit *u = get_visible_unit(rc);
 	return unit_status(rc,u);
 }
-REPORT_GENERATOR(selected_unit_status, rc)
+REPORT_GENERATOR(selected_unit_status, SELECTED_UNIT_DEPS, rc)
 {
 	const unit *u = get_selected_unit(rc);
 	return unit_status(rc, u);
@@ -391,7 +411,7 @@ static config unit_alignment(const reports::context& rc, const unit* u, const ma
 
 	return text_report(str.str(), tooltip.str(), "time_of_day");
 }
-REPORT_GENERATOR(unit_alignment, rc)
+REPORT_GENERATOR(unit_alignment, DISPLAYED_UNIT_DEPS | reports::DEP_TOD, rc)
 {
 	const unit *u = get_visible_unit(rc);
 	const map_location& mouseover_hex = rc.screen().mouseover_hex();
@@ -399,7 +419,7 @@ REPORT_GENERATOR(unit_alignment, rc)
 	const map_location& hex = mouseover_hex.valid() ? mouseover_hex : displayed_unit_hex;
 	return unit_alignment(rc, u, hex);
 }
-REPORT_GENERATOR(selected_unit_alignment, rc)
+REPORT_GENERATOR(selected_unit_alignment, BOTH_UNITS_DEPS | reports::DEP_TOD, rc)
 {
 	const unit *u = get_selected_unit(rc);
 	const map_location& attack_indicator_src = game_display::get_singleton()->get_attack_indicator_src();
@@ -445,7 +465,7 @@ static config unit_abilities(const unit* u, const map_location& loc)
 
 	return res;
 }
-REPORT_GENERATOR(unit_abilities, rc)
+REPORT_GENERATOR(unit_abilities, DISPLAYED_UNIT_DEPS, rc)
 {
 	const unit *u = get_visible_unit(rc);
 	const team &viewing_team = rc.teams()[rc.screen().viewing_team()];
@@ -455,7 +475,7 @@ REPORT_GENERATOR(unit_abilities, rc)
 
 	return unit_abilities(u, hex);
 }
-REPORT_GENERATOR(selected_unit_abilities, rc)
+REPORT_GENERATOR(selected_unit_abilities, SELECTED_UNIT_DEPS, rc)
 {
 	const unit *u = get_selected_unit(rc);
 
@@ -512,12 +532,12 @@ static config unit_hp(const reports::context& rc, const unit* u)
 	}
 	return text_report(str.str(), tooltip.str());
 }
-REPORT_GENERATOR(unit_hp, rc)
+REPORT_GENERATOR(unit_hp, DISPLAYED_UNIT_DEPS, rc)
 {
 	const unit *u = get_visible_unit(rc);
 	return unit_hp(rc, u);
 }
-REPORT_GENERATOR(selected_unit_hp, rc)
+REPORT_GENERATOR(selected_unit_hp, SELECTED_UNIT_DEPS, rc)
 {
 	const unit *u = get_selected_unit(rc);
 	return unit_hp(rc, u);
@@ -539,12 +559,12 @@ static config unit_xp(const unit* u)
 	tooltip << _("Experience Modifier: ") << exp_mod << '%';
 	return text_report(str.str(), tooltip.str());
 }
-REPORT_GENERATOR(unit_xp, rc)
+REPORT_GENERATOR(unit_xp, DISPLAYED_UNIT_DEPS, rc)
 {
 	const unit *u = get_visible_unit(rc);
 	return unit_xp(u);
 }
-REPORT_GENERATOR(selected_unit_xp, rc)
+REPORT_GENERATOR(selected_unit_xp, SELECTED_UNIT_DEPS, rc)
 {
 	const unit *u = get_selected_unit(rc);
 	return unit_xp(u);
@@ -559,12 +579,12 @@ static config unit_advancement_options(const unit* u)
 	}
 	return res;
 }
-REPORT_GENERATOR(unit_advancement_options, rc)
+REPORT_GENERATOR(unit_advancement_options, DISPLAYED_UNIT_DEPS, rc)
 {
 	const unit *u = get_visible_unit(rc);
 	return unit_advancement_options(u);
 }
-REPORT_GENERATOR(selected_unit_advancement_options, rc)
+REPORT_GENERATOR(selected_unit_advancement_options, SELECTED_UNIT_DEPS, rc)
 {
 	const unit *u = get_selected_unit(rc);
 	return unit_advancement_options(u);
@@ -612,7 +632,7 @@ static config unit_defense(const reports::context& rc, const unit* u, const map_
 	const std::string has_variations_prefix = (u->type().show_variations_in_help() ? ".." : "");
 	return text_report(str.str(), tooltip.str(), has_variations_prefix + "unit_" + u->type_id());
 }
-REPORT_GENERATOR(unit_defense,rc)
+REPORT_GENERATOR(unit_defense, DISPLAYED_UNIT_DEPS, rc)
 {
 	const unit *u = get_visible_unit(rc);
 	const team &viewing_team = rc.teams()[rc.screen().viewing_team()];
@@ -621,7 +641,7 @@ REPORT_GENERATOR(unit_defense,rc)
 	const map_location& hex = (mouseover_hex.valid() && !viewing_team.shrouded(mouseover_hex)) ? mouseover_hex : displayed_unit_hex;
 	return unit_defense(rc, u, hex);
 }
-REPORT_GENERATOR(selected_unit_defense, rc)
+REPORT_GENERATOR(selected_unit_defense, BOTH_UNITS_DEPS, rc)
 {
 	const unit *u = get_selected_unit(rc);
 	const map_location& attack_indicator_src = game_display::get_singleton()->get_attack_indicator_src();
@@ -653,12 +673,12 @@ static config unit_vision(const unit* u)
 	}
 	return text_report(str.str(), tooltip.str());
 }
-REPORT_GENERATOR(unit_vision, rc)
+REPORT_GENERATOR(unit_vision, DISPLAYED_UNIT_DEPS, rc)
 {
 	const unit* u = get_visible_unit(rc);
 	return unit_vision(u);
 }
-REPORT_GENERATOR(selected_unit_vision, rc)
+REPORT_GENERATOR(selected_unit_vision, SELECTED_UNIT_DEPS, rc)
 {
 	const unit* u = get_selected_unit(rc);
 	return unit_vision(u);
@@ -746,12 +766,12 @@ static config unit_moves(const reports::context& rc, const unit* u, bool is_visi
 	str << span_color(c) << numerator << '/' << u->total_movement() << naps;
 	return text_report(str.str(), tooltip.str());
 }
-REPORT_GENERATOR(unit_moves, rc)
+REPORT_GENERATOR(unit_moves, DISPLAYED_UNIT_DEPS, rc)
 {
 	const unit *u = get_visible_unit(rc);
 	return unit_moves(rc, u, true);
 }
-REPORT_GENERATOR(selected_unit_moves, rc)
+REPORT_GENERATOR(selected_unit_moves, SELECTED_UNIT_DEPS, rc)
 {
 	const unit *u = get_selected_unit(rc);
 	return unit_moves(rc, u, false);
@@ -1178,7 +1198,7 @@ static config unit_weapons(const reports::context& rc, const unit *u, const map_
 	}
 	return res;
 }
-REPORT_GENERATOR(unit_weapons, rc)
+REPORT_GENERATOR(unit_weapons, DISPLAYED_UNIT_DEPS | reports::DEP_TOD, rc)
 {
 	const unit *u = get_visible_unit(rc);
 	const map_location& mouseover_hex = rc.screen().mouseover_hex();
@@ -1188,7 +1208,7 @@ REPORT_GENERATOR(unit_weapons, rc)
 
 	return unit_weapons(rc, u, hex);
 }
-REPORT_GENERATOR(highlighted_unit_weapons, rc)
+REPORT_GENERATOR(highlighted_unit_weapons, BOTH_UNITS_DEPS | reports::DEP_TOD, rc)
 {
 	unit_const_ptr u = get_selected_unit_ptr(rc);
 	const unit *sec_u = get_visible_unit(rc);
@@ -1207,7 +1227,7 @@ REPORT_GENERATOR(highlighted_unit_weapons, rc)
 	//TODO: shouldn't this pass sec_u as secodn parameter ?
 	return unit_weapons(rc, u, attack_loc, sec_u, false);
 }
-REPORT_GENERATOR(selected_unit_weapons, rc)
+REPORT_GENERATOR(selected_unit_weapons, BOTH_UNITS_DEPS | reports::DEP_TOD, rc)
 {
 	unit_const_ptr u = get_selected_unit_ptr(rc);
 	const unit *sec_u = get_visible_unit(rc);
@@ -1226,26 +1246,26 @@ REPORT_GENERATOR(selected_unit_weapons, rc)
 	return unit_weapons(rc, u, attack_loc, sec_u, true);
 }
 
-REPORT_GENERATOR(unit_image,rc)
+REPORT_GENERATOR(unit_image, DISPLAYED_UNIT_DEPS, rc)
 {
 	const unit *u = get_visible_unit(rc);
 	if (!u) return config();
 	return image_report(u->absolute_image() + u->image_mods());
 }
-REPORT_GENERATOR(selected_unit_image, rc)
+REPORT_GENERATOR(selected_unit_image, SELECTED_UNIT_DEPS, rc)
 {
 	const unit *u = get_selected_unit(rc);
 	if (!u) return config();
 	return image_report(u->absolute_image() + u->image_mods());
 }
 
-REPORT_GENERATOR(selected_unit_profile, rc)
+REPORT_GENERATOR(selected_unit_profile, SELECTED_UNIT_DEPS, rc)
 {
 	const unit *u = get_selected_unit(rc);
 	if (!u) return config();
 	return image_report(u->small_profile());
 }
-REPORT_GENERATOR(unit_profile, rc)
+REPORT_GENERATOR(unit_profile, DISPLAYED_UNIT_DEPS, rc)
 {
 	const unit *u = get_visible_unit(rc);
 	if (!u) return config();
@@ -1275,13 +1295,13 @@ static config tod_stats_at(const reports::context& rc, const map_location& hex)
 
 	return text_report(text.str(), tooltip.str(), "..schedule");
 }
-REPORT_GENERATOR(tod_stats, rc)
+REPORT_GENERATOR(tod_stats, reports::DEP_MOUSEOVER | reports::DEP_SELECTED_UNIT | reports::DEP_TOD | reports::DEP_VIEWING_TEAM, rc)
 {
 	map_location mouseover_hex = rc.screen().mouseover_hex();
 	if (mouseover_hex.valid()) return tod_stats_at(rc, mouseover_hex);
 	return tod_stats_at(rc, rc.screen().selected_hex());
 }
-REPORT_GENERATOR(selected_tod_stats, rc)
+REPORT_GENERATOR(selected_tod_stats, BOTH_UNITS_DEPS | reports::DEP_TOD, rc)
 {
 	const unit *u = get_selected_unit(rc);
 	if(!u) return tod_stats_at(rc, map_location::null_location());
@@ -1327,13 +1347,13 @@ static config time_of_day_at(const reports::context& rc, const map_location& mou
 
 	return image_report(tod_image, tooltip.str(), "time_of_day_" + tod.id);
 }
-REPORT_GENERATOR(time_of_day, rc)
+REPORT_GENERATOR(time_of_day, reports::DEP_MOUSEOVER | reports::DEP_SELECTED_UNIT | reports::DEP_TOD | reports::DEP_VIEWING_TEAM, rc)
 {
 	map_location mouseover_hex = rc.screen().mouseover_hex();
 	if (mouseover_hex.valid()) return time_of_day_at(rc, mouseover_hex);
 	return time_of_day_at(rc, rc.screen().selected_hex());
 }
-REPORT_GENERATOR(selected_time_of_day, rc)
+REPORT_GENERATOR(selected_time_of_day, BOTH_UNITS_DEPS | reports::DEP_TOD, rc)
 {
 	const unit *u = get_selected_unit(rc);
 	if(!u) return time_of_day_at(rc, map_location::null_location());
@@ -1414,14 +1434,14 @@ static config unit_box_at(const reports::context& rc, const map_location& mouseo
 
 	return image_report(tod_image + bg_terrain_image + unit_image, tooltip.str(), "time_of_day");
 }
-REPORT_GENERATOR(unit_box, rc)
+REPORT_GENERATOR(unit_box, DISPLAYED_UNIT_DEPS | reports::DEP_TOD, rc)
 {
 	map_location mouseover_hex = rc.screen().mouseover_hex();
 	return unit_box_at(rc, mouseover_hex);
 }
 
 
-REPORT_GENERATOR(turn, rc)
+REPORT_GENERATOR(turn, reports::DEP_TOD, rc)
 {
 	std::ostringstream str, tooltip;
 	str << rc.tod().turn();
@@ -1435,7 +1455,7 @@ REPORT_GENERATOR(turn, rc)
 	return text_report(str.str(), tooltip.str());
 }
 
-REPORT_GENERATOR(gold, rc)
+REPORT_GENERATOR(gold, reports::DEP_GOLD | reports::DEP_VIEWING_TEAM, rc)
 {
 	std::ostringstream str;
 	int viewing_side = rc.screen().viewing_side();
@@ -1458,7 +1478,7 @@ REPORT_GENERATOR(gold, rc)
 	return text_report(str.str(), _("Gold") + "\n\n" + _("The amount of gold currently available to recruit and maintain your army."));
 }
 
-REPORT_GENERATOR(villages, rc)
+REPORT_GENERATOR(villages, reports::DEP_VIEWING_TEAM | reports::DEP_UNITS, rc)
 {
 	std::ostringstream str;
 	int viewing_side = rc.screen().viewing_side();
@@ -1477,12 +1497,12 @@ REPORT_GENERATOR(villages, rc)
 	return gray_inactive(rc,str.str(), _("Villages") + "\n\n" + _("The fraction of known villages that your side has captured."));
 }
 
-REPORT_GENERATOR(num_units, rc)
+REPORT_GENERATOR(num_units, reports::DEP_VIEWING_TEAM | reports::DEP_UNITS, rc)
 {
 	return gray_inactive(rc, std::to_string(rc.dc().side_units(rc.screen().viewing_side())), _("Units") + "\n\n" + _("The total number of units on your side."));
 }
 
-REPORT_GENERATOR(upkeep, rc)
+REPORT_GENERATOR(upkeep, reports::DEP_VIEWING_TEAM | reports::DEP_UNITS, rc)
 {
 	std::ostringstream str;
 	int viewing_side = rc.screen().viewing_side();
@@ -1492,7 +1512,7 @@ REPORT_GENERATOR(upkeep, rc)
 	return gray_inactive(rc,str.str(), _("Upkeep") + "\n\n" + _("The expenses incurred at the end of every turn to maintain your army. The first number is the amount of gold that will be deducted. It is equal to the number of unit levels not supported by villages. The second is the total cost of upkeep, including that covered by villages — in other words, the amount of gold that would be deducted if you lost all villages."));
 }
 
-REPORT_GENERATOR(expenses, rc)
+REPORT_GENERATOR(expenses, reports::DEP_VIEWING_TEAM | reports::DEP_UNITS, rc)
 {
 	int viewing_side = rc.screen().viewing_side();
 	const team &viewing_team = rc.dc().get_team(viewing_side);
@@ -1500,7 +1520,7 @@ REPORT_GENERATOR(expenses, rc)
 	return gray_inactive(rc,std::to_string(td.expenses));
 }
 
-REPORT_GENERATOR(income, rc)
+REPORT_GENERATOR(income, reports::DEP_VIEWING_TEAM | reports::DEP_UNITS, rc)
 {
 	std::ostringstream str;
 	int viewing_side = rc.screen().viewing_side();
@@ -1538,7 +1558,7 @@ void blit_tced_icon(config &cfg, const std::string &terrain_id, const std::strin
 }
 }
 
-REPORT_GENERATOR(terrain_info, rc)
+REPORT_GENERATOR(terrain_info, reports::DEP_MOUSEOVER | reports::DEP_SELECTED_UNIT | reports::DEP_VIEWING_TEAM, rc)
 {
 	const gamemap& map = rc.map();
 	map_location mouseover_hex = rc.screen().mouseover_hex();
@@ -1616,7 +1636,7 @@ REPORT_GENERATOR(terrain_info, rc)
 	return cfg;
 }
 
-REPORT_GENERATOR(terrain, rc)
+REPORT_GENERATOR(terrain, reports::DEP_MOUSEOVER | reports::DEP_VIEWING_TEAM, rc)
 {
 	const gamemap &map = rc.map();
 	int viewing_side = rc.screen().viewing_side();
@@ -1654,7 +1674,7 @@ REPORT_GENERATOR(terrain, rc)
 	return text_report(str.str());
 }
 
-REPORT_GENERATOR(zoom_level, rc)
+REPORT_GENERATOR(zoom_level, reports::DEP_UNTRACKED, rc)
 {
 	std::ostringstream text;
 	std::ostringstream tooltip;
@@ -1665,7 +1685,7 @@ REPORT_GENERATOR(zoom_level, rc)
 	return text_report(text.str(), tooltip.str(), help.str());
 }
 
-REPORT_GENERATOR(position, rc)
+REPORT_GENERATOR(position, BOTH_UNITS_DEPS, rc)
 {
 	const gamemap &map = rc.map();
 	map_location mouseover_hex = rc.screen().mouseover_hex(),
@@ -1707,7 +1727,7 @@ REPORT_GENERATOR(position, rc)
 	return text_report(str.str());
 }
 
-REPORT_GENERATOR(side_playing, rc)
+REPORT_GENERATOR(side_playing, reports::DEP_VIEWING_TEAM, rc)
 {
 	const team &active_team = rc.teams()[rc.screen().playing_team()];
 	std::string flag_icon = active_team.flag_icon();
@@ -1719,7 +1739,7 @@ REPORT_GENERATOR(side_playing, rc)
 	return image_report(flag_icon + mods, side_tooltip(active_team));
 }
 
-REPORT_GENERATOR(observers, rc)
+REPORT_GENERATOR(observers, reports::DEP_UNTRACKED, rc)
 {
 	const std::set<std::string> &observers = rc.screen().observers();
 	if (observers.empty())
@@ -1733,7 +1753,7 @@ REPORT_GENERATOR(observers, rc)
 	return image_report(game_config::images::observer, str.str());
 }
 
-REPORT_GENERATOR(report_clock, /*rc*/)
+REPORT_GENERATOR(report_clock, reports::DEP_UNTRACKED, /*rc*/)
 {
 	config report;
 	add_image(report, game_config::images::time_icon, "");
@@ -1752,7 +1772,7 @@ REPORT_GENERATOR(report_clock, /*rc*/)
 }
 
 
-REPORT_GENERATOR(battery, /*rc*/)
+REPORT_GENERATOR(battery, reports::DEP_UNTRACKED, /*rc*/)
 {
 	config report;
 
@@ -1762,7 +1782,7 @@ REPORT_GENERATOR(battery, /*rc*/)
 	return report;
 }
 
-REPORT_GENERATOR(report_countdown, rc)
+REPORT_GENERATOR(report_countdown, reports::DEP_UNTRACKED, rc)
 {
 	int viewing_side = rc.screen().viewing_side();
 	const team &viewing_team = rc.dc().get_team(viewing_side);
@@ -1799,6 +1819,22 @@ void reports::register_generator(const std::string &name, reports::generator *g)
 }
 
 config reports::generate_report(const std::string &name, const reports::context& rc, bool only_static)
+{
+	const frame_profiler::scope profiler_scope(frame_profiler::section::reports);
+	if (!collect_timings_)
+		return generate(name, rc, only_static);
+
+	const utils::optimer<std::chrono::microseconds> timer([this, &name](const auto& t) {
+		timing& stats = timings_[name];
+		const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(t.elapsed());
+		++stats.calls;
+		stats.total += elapsed;
+		stats.max = std::max(stats.max, elapsed);
+	});
+	return generate(name, rc, only_static);
+}
+
+config reports::generate(const std::string &name, const reports::context& rc, bool only_static)
 {
 	if (!only_static) {
 		dynamic_report_generators::const_iterator i = dynamic_generators_.find(name);
@@ -1807,10 +1843,20 @@ config reports::generate_report(const std::string &name, const reports::context&
 	}
 	static_report_generators::const_iterator j = static_generators.find(name);
 	if (j != static_generators.end())
-		return j->second(rc);
+		return j->second.generate(rc);
 	return config();
 }
 
+unsigned reports::dependencies(const std::string &name) const
+{
+	if (dynamic_generators_.count(name) != 0)
+		return DEP_ALL;
+	static_report_generators::const_iterator j = static_generators.find(name);
+	if (j != static_generators.end())
+		return j->second.dependencies;
+	return DEP_ALL;
+}
+
 const std::set<std::string> &reports::report_list()
 {
 	if (!all_reports_.empty()) return all_reports_;
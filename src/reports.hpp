@@ -17,6 +17,7 @@
 
 #include "display_context.hpp"
 
+#include <chrono>
 #include <vector>
 
 #include "utils/optional_reference.hpp"
@@ -66,18 +67,69 @@ public:
 		utils::optional_reference<events::mouse_handler> mhb_;
 	};
 
+	/**
+	 * Inputs a report generator reads. The display only regenerates a report
+	 * when one of the inputs it declares has changed since the last refresh.
+	 */
+	enum dependency : unsigned
+	{
+		DEP_NONE          = 0,
+		/** The hex under the mouse and the unit displayed from it. */
+		DEP_MOUSEOVER     = 1 << 0,
+		/** The selected hex and the unit on it. */
+		DEP_SELECTED_UNIT = 1 << 1,
+		/** Gold of the viewing side, including whiteboard spending. */
+		DEP_GOLD          = 1 << 2,
+		/** Turn number and time of day. */
+		DEP_TOD           = 1 << 3,
+		/** Viewing and playing teams, and what they can see. */
+		DEP_VIEWING_TEAM  = 1 << 4,
+		/** State of the units themselves (hitpoints, moves, experience...). */
+		DEP_UNITS         = 1 << 5,
+		/** Anything else; set on every refresh of the game status. */
+		DEP_UNTRACKED     = 1 << 6,
+		DEP_ALL           = ~0u
+	};
+
 	struct generator
 	{
 		virtual config generate(const context& ct) = 0;
 		virtual ~generator() {}
 	};
 
+	/** Accumulated generation time of a single report. */
+	struct timing
+	{
+		unsigned calls = 0;
+		std::chrono::microseconds total{0};
+		std::chrono::microseconds max{0};
+	};
+
 	void register_generator(const std::string &name, generator *);
 
 	config generate_report(const std::string &name, const context& ct, bool only_static = false);
 
+	/**
+	 * Returns the reports::dependency bits of the given report.
+	 * Dynamic (Lua) generators cannot declare them and depend on everything.
+	 */
+	unsigned dependencies(const std::string &name) const;
+
 	const std::set<std::string> &report_list();
 
+	/** Generation time per report name, collected since the last reset_timings(). */
+	const std::map<std::string, timing>& timings() const { return timings_; }
+	void reset_timings() { timings_.clear(); }
+
+	/** Whether generate_report() measures the generation times. Off by default. */
+	void set_collect_timings(bool collect)
+	{
+		collect_timings_ = collect;
+		if(!collect) {
+			timings_.clear();
+		}
+	}
+
 	using generator_function = std::function<config(const reports::context&)>;
 
 	typedef std::map<std::string, std::shared_ptr<reports::generator>> dynamic_report_generators;
@@ -88,4 +140,9 @@ private:
 
 	dynamic_report_generators dynamic_generators_;
 
+	std::map<std::string, timing> timings_;
+	bool collect_timings_ = false;
+
+	config generate(const std::string &name, const context& ct, bool only_static);
+
 };
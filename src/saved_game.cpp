@@ -69,6 +69,7 @@
 #include "formula/string_utils.hpp"
 #include "game_config_manager.hpp"
 #include "generators/map_create.hpp"
+#include "load_profiler.hpp"
 #include "log.hpp"
 #include "random.hpp"
 #include "serialization/binary_or_text.hpp"
@@ -283,7 +284,12 @@ void saved_game::set_defaults()
 void saved_game::expand_scenario()
 {
 	if(starting_point_type_ == starting_point::NONE && !has_carryover_expanded_) {
-		game_config_manager::get()->load_game_config_for_game(classification(), carryover_["next_scenario"]);
+		load_profiler::scope profile("saved_game::expand_scenario");
+
+		{
+			load_profiler::scope profile_config("load_game_config_for_game");
+			game_config_manager::get()->load_game_config_for_game(classification(), carryover_["next_scenario"]);
+		}
 
 		const game_config_view& game_config = game_config_manager::get()->game_config();
 		auto scenario =
@@ -385,6 +391,7 @@ void saved_game::load_non_scenario(const std::string& type, const std::string& i
 void saved_game::expand_mp_events()
 {
 	expand_scenario();
+	load_profiler::scope profile("saved_game::expand_mp_events");
 
 	if(starting_point_type_ == starting_point::SCENARIO && !starting_point_["has_mod_events"].to_bool(false)) {
 		std::vector<modevents_entry> mods;
@@ -425,6 +432,7 @@ void saved_game::expand_mp_events()
 
 void saved_game::expand_mp_options()
 {
+	load_profiler::scope profile("saved_game::expand_mp_options");
 	if(starting_point_type_ == starting_point::SCENARIO && !has_carryover_expanded_) {
 		std::vector<modevents_entry> mods;
 
@@ -504,6 +512,7 @@ void saved_game::expand_map_file(config& scenario)
 void saved_game::expand_random_scenario()
 {
 	expand_scenario();
+	load_profiler::scope profile("saved_game::expand_random_scenario");
 
 	if(starting_point_type_ == starting_point::SCENARIO) {
 		// If the entire scenario should be randomly generated
@@ -565,6 +574,7 @@ void saved_game::post_scenario_generation(const config& old_scenario, config& ge
 void saved_game::expand_carryover()
 {
 	expand_scenario();
+	load_profiler::scope profile("saved_game::expand_carryover");
 	if(starting_point_type_ == starting_point::SCENARIO && !has_carryover_expanded_) {
 		carryover_info sides(carryover_);
 
@@ -29,6 +29,9 @@
 #include "units/map.hpp"
 #include "units/unit.hpp"
 
+#include <optional>
+#include <unordered_map>
+
 static const char formulaKey[] = "formula";
 
 using namespace wfl;
@@ -128,19 +131,26 @@ void luaW_pushfaivariant(lua_State* L, variant val) {
 		const std::string result_string = val.as_string();
 		lua_pushlstring(L, result_string.c_str(), result_string.size());
 	} else if(val.is_list()) {
-		lua_newtable(L);
-		for(const variant& v : val.as_list()) {
-			lua_pushinteger(L, lua_rawlen(L, -1) + 1);
+		const std::vector<variant>& list = val.as_list();
+		lua_createtable(L, list.size(), 0);
+		int i = 1;
+		for(const variant& v : list) {
 			luaW_pushfaivariant(L, v);
-			lua_settable(L, -3);
+			// Null entries are dropped, as with the old rawlen-based append, so the result stays a sequence.
+			if(lua_isnil(L, -1)) {
+				lua_pop(L, 1);
+			} else {
+				lua_rawseti(L, -2, i++);
+			}
 		}
 	} else if(val.is_map()) {
 		typedef std::map<variant,variant>::value_type kv_type;
-		lua_newtable(L);
-		for(const kv_type& v : val.as_map()) {
+		const std::map<variant,variant>& map = val.as_map();
+		lua_createtable(L, 0, map.size());
+		for(const kv_type& v : map) {
 			luaW_pushfaivariant(L, v.first);
 			luaW_pushfaivariant(L, v.second);
-			lua_settable(L, -3);
+			lua_rawset(L, -3);
 		}
 	} else if(val.is_callable()) {
 		// First try a few special cases
@@ -217,6 +227,30 @@ variant luaW_tofaivariant(lua_State* L, int i) {
 	return variant();
 }
 
+/**
+ * Formulas passed to eval_formula() as strings, so that scripts evaluating
+ * the same formula over and over only parse it once. Formulas are immutable
+ * once parsed, so sharing them is safe even while one is being evaluated.
+ */
+static std::shared_ptr<formula> get_cached_formula(const std::string& code)
+{
+	static std::unordered_map<std::string, std::shared_ptr<formula>> cache;
+	// Formulas built from changing values would otherwise grow the cache forever.
+	static const std::size_t max_size = 1000;
+
+	auto it = cache.find(code);
+	if(it != cache.end()) {
+		return it->second;
+	}
+
+	auto parsed = std::make_shared<formula>(code);
+	if(cache.size() >= max_size) {
+		cache.clear();
+	}
+	cache.emplace(code, parsed);
+	return parsed;
+}
+
 /**
  * Evaluates a formula in the formula engine.
  * - Arg 1: Formula string.
@@ -225,13 +259,13 @@ variant luaW_tofaivariant(lua_State* L, int i) {
  */
 int lua_formula_bridge::intf_eval_formula(lua_State *L)
 {
-	bool need_delete = false;
-	fwrapper* form;
+	std::optional<fwrapper> parsed;
+	const fwrapper* form;
 	if(void* ud = luaL_testudata(L, 1, formulaKey)) {
 		form = static_cast<fwrapper*>(ud);
 	} else {
-		need_delete = true;
-		form = new fwrapper(luaL_checkstring(L, 1));
+		parsed.emplace(get_cached_formula(luaL_checkstring(L, 1)));
+		form = &*parsed;
 	}
 	std::shared_ptr<formula_callable> context, fallback;
 	if(unit* u = luaW_tounit(L, 2)) {
@@ -249,9 +283,6 @@ int lua_formula_bridge::intf_eval_formula(lua_State *L)
 	}
 	variant result = form->evaluate(*context);
 	luaW_pushfaivariant(L, result);
-	if(need_delete) {
-		delete form;
-	}
 	return 1;
 }
 
@@ -270,6 +301,11 @@ lua_formula_bridge::fwrapper::fwrapper(const std::string& code, function_symbol_
 {
 }
 
+lua_formula_bridge::fwrapper::fwrapper(std::shared_ptr<formula> parsed)
+	: formula_ptr(std::move(parsed))
+{
+}
+
 std::string lua_formula_bridge::fwrapper::str() const
 {
 	if(formula_ptr) {
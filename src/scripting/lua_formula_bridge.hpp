@@ -37,6 +37,8 @@ namespace lua_formula_bridge {
 		std::shared_ptr<wfl::formula> formula_ptr;
 	public:
 		fwrapper(const std::string& code, wfl::function_symbol_table* functions = nullptr);
+		/** Wraps an already parsed formula. */
+		explicit fwrapper(std::shared_ptr<wfl::formula> parsed);
 		std::string str() const;
 		wfl::variant evaluate(const wfl::formula_callable& variables, wfl::formula_debugger* fdb = nullptr) const;
 	};
@@ -29,6 +29,7 @@
 #include "units/animation_component.hpp"
 #include "game_version.hpp"
 #include "deprecation.hpp"
+#include "display.hpp"
 
 
 static lg::log_domain log_scripting_lua("scripting/lua");
@@ -426,6 +427,11 @@ static int impl_unit_set(lua_State *L)
 	if (!pu) return luaL_argerror(L, 1, "unknown unit");
 	unit &u = *pu;
 
+	// The sidebar may show this unit.
+	if (display* disp = display::get_singleton()) {
+		disp->invalidate_game_status();
+	}
+
 	// Find the corresponding attribute.
 	//modify_int_attrib_check_range("side", u.set_side(value), 1, static_cast<int>(teams().size())); TODO: Figure out if this is a good idea, to refer to teams() and make this depend on having a gamestate
 	modify_int_attrib("side", u.set_side(value));
@@ -15,6 +15,7 @@
 #include "sdl/texture.hpp"
 
 #include "color.hpp"
+#include "frame_profiler.hpp"
 #include "log.hpp"
 #include "sdl/point.hpp"
 #include "sdl/surface.hpp"
@@ -66,7 +67,10 @@ texture::texture(const surface& surf, bool linear_interpolation)
 	const char* scale_quality = linear_interpolation ? "linear" : "nearest";
 	SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, scale_quality);
 
-	texture_.reset(SDL_CreateTextureFromSurface(renderer, surf), &cleanup_texture);
+	{
+		const frame_profiler::scope profiler_scope(frame_profiler::section::texture_upload);
+		texture_.reset(SDL_CreateTextureFromSurface(renderer, surf), &cleanup_texture);
+	}
 	if(!texture_) {
 		ERR_SDL << "When creating texture from surface: " << SDL_GetError();
 	}
@@ -268,7 +268,10 @@ node::node(document& doc, node* parent, const char** str, int depth) :
 		case ' ':
 		case '\t':
 		case '\n':
-			++s;
+			// Skip the whole run of indentation at once.
+			do {
+				++s;
+			} while(*s == '\t' || *s == ' ' || *s == '\n');
 			break;
 		case '#':
 			s = strchr(s, '\n');
@@ -607,11 +610,10 @@ void node::remove_child(const char* name, std::size_t index)
 
 node* node::child(const char* name)
 {
-	for(child_map::iterator i = children_.begin(); i != children_.end(); ++i) {
-		if(i->first == name) {
-			assert(i->second.empty() == false);
-			return i->second.front();
-		}
+	child_map::iterator i = find_in_map(children_, string_span(name));
+	if(i != children_.end()) {
+		assert(i->second.empty() == false);
+		return i->second.front();
 	}
 
 	return nullptr;
@@ -619,14 +621,9 @@ node* node::child(const char* name)
 
 const node* node::child(const char* name) const
 {
-	for(child_map::const_iterator i = children_.begin(); i != children_.end(); ++i) {
-		if(i->first == name) {
-			if(i->second.empty()) {
-				return nullptr;
-			} else {
-				return i->second.front();
-			}
-		}
+	child_map::const_iterator i = find_in_map(children_, string_span(name));
+	if(i != children_.end() && i->second.empty() == false) {
+		return i->second.front();
 	}
 
 	return nullptr;
@@ -634,10 +631,9 @@ const node* node::child(const char* name) const
 
 const node::child_list& node::children(const char* name) const
 {
-	for(child_map::const_iterator i = children_.begin(); i != children_.end(); ++i) {
-		if(i->first == name) {
-			return i->second;
-		}
+	child_map::const_iterator i = find_in_map(children_, string_span(name));
+	if(i != children_.end()) {
+		return i->second;
 	}
 
 	static const node::child_list empty;
@@ -651,10 +647,9 @@ int node::get_children(const char* name)
 
 int node::get_children(const string_span& name)
 {
-	for(child_map::iterator i = children_.begin(); i != children_.end(); ++i) {
-		if(i->first == name) {
-			return std::distance(children_.begin(), i);
-		}
+	child_map::iterator i = find_in_map(children_, name);
+	if(i != children_.end()) {
+		return std::distance(children_.begin(), i);
 	}
 
 	children_.emplace_back(string_span(name), child_list());
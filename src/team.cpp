@@ -48,6 +48,7 @@ static lg::log_domain log_engine_enemies("engine/enemies");
 
 // Static member initialization
 const int team::default_team_gold_ = 100;
+std::size_t team::villages_revision_ = 1;
 
 // Update this list of attributes if you change what is used to define a side
 // (excluding those attributes used to define the side's leader).
@@ -387,6 +388,7 @@ void team::build(const config& cfg, const gamemap& map, int gold)
 		map_location loc(v);
 		if(map.is_village(loc)) {
 			villages_.insert(loc);
+			++villages_revision_;
 		} else {
 			WRN_NG << "[side] " << current_player() << " [village] points to a non-village location " << loc;
 		}
@@ -429,6 +431,7 @@ void team::fix_villages(const gamemap &map)
 		}
 		else {
 			it = villages_.erase(it);
+			++villages_revision_;
 		}
 	}
 }
@@ -436,6 +439,7 @@ void team::fix_villages(const gamemap &map)
 game_events::pump_result_t team::get_village(const map_location& loc, const int owner_side, game_data* gamedata)
 {
 	villages_.insert(loc);
+	++villages_revision_;
 	game_events::pump_result_t res;
 
 	if(gamedata) {
@@ -464,6 +468,7 @@ void team::lose_village(const map_location& loc)
 	const std::set<map_location>::const_iterator vil = villages_.find(loc);
 	assert(vil != villages_.end());
 	villages_.erase(vil);
+	++villages_revision_;
 }
 
 void team::set_recruits(const std::set<std::string>& recruits)
@@ -166,8 +166,10 @@ public:
 	 */
 	game_events::pump_result_t get_village(const map_location&, const int owner_side, game_data * fire_event);
 	void lose_village(const map_location&);
-	void clear_villages() { villages_.clear(); }
+	void clear_villages() { villages_.clear(); ++villages_revision_; }
 	const std::set<map_location>& villages() const { return villages_; }
+	/** Incremented whenever the villages of any team change. */
+	static std::size_t villages_revision() { return villages_revision_; }
 	bool owns_village(const map_location& loc) const
 		{ return villages_.count(loc) > 0; }
 
@@ -404,6 +406,7 @@ private:
 
 	int gold_;
 	std::set<map_location> villages_;
+	static std::size_t villages_revision_;
 
 	shroud_map shroud_, fog_;
 	/** Stores hexes that have been cleared of fog via WML. */
@@ -22,16 +22,28 @@
 
 #include "gui/dialogs/loading_screen.hpp"
 #include "picture.hpp"
+#include "load_profiler.hpp"
 #include "log.hpp"
 #include "map/map.hpp"
 #include "preferences/game.hpp"
 #include "serialization/string_utils.hpp"
+#include "config.hpp"
 #include "game_config_view.hpp"
 
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+
+#include <future>
+#include <optional>
+#include <thread>
+
 static lg::log_domain log_engine("engine");
 #define ERR_NG LOG_STREAM(err, log_engine)
 #define WRN_NG LOG_STREAM(warn, log_engine)
 
+static lg::log_domain log_terrain_builder("engine/terrain_builder");
+#define LOG_TB LOG_STREAM(info, log_terrain_builder)
+
 /**
  *
  * These legacy map_location functions moved here from map_location.?pp.
@@ -129,9 +141,9 @@ void terrain_builder::tile::rebuild_cache(const std::string& tod, logs* log)
 		for(const rule_image_variant& variant : ri->variants) {
 			if(!variant.has_flag.empty()) {
 				bool has_flag_match = true;
-				for(const std::string& s : variant.has_flag) {
+				for(unsigned id : variant.has_flag_ids) {
 					// If a flag listed in "has_flag" is not present, this variant does not match
-					if(flags.find(s) == flags.end()) {
+					if(!has_flag(id)) {
 						has_flag_match = false;
 						break;
 					}
@@ -183,6 +195,16 @@ void terrain_builder::tile::rebuild_cache(const std::string& tod, logs* log)
 	}
 }
 
+std::vector<std::string> terrain_builder::tile::flag_names() const
+{
+	std::vector<std::string> res;
+	for(std::size_t id = flags.find_first(); id != boost::dynamic_bitset<>::npos; id = flags.find_next(id)) {
+		res.push_back(flag_names_[id]);
+	}
+	std::sort(res.begin(), res.end());
+	return res;
+}
+
 void terrain_builder::tile::clear()
 {
 	flags.clear();
@@ -247,9 +269,24 @@ terrain_builder::terrain_builder(const config& level, const gamemap* m, const st
 	, terrain_by_type_()
 	, draw_border_(draw_border)
 {
-	image::precache_file_existence("terrain/");
+	load_profiler::scope profile("terrain_builder");
 
-	if(building_rules_.empty() && rules_cfg_) {
+	{
+		load_profiler::scope profile_images("image preloading");
+		image::precache_file_existence("terrain/");
+	}
+
+	if(global_rules_prepared_) {
+		// The global rules were parsed in advance. The off map rule still has to
+		// come first among the rules of its precedence, so add it to an empty set
+		// and merge the global rules after it, in order.
+		building_ruleset prepared;
+		std::swap(prepared, building_rules_);
+		add_off_map_rule(offmap_image);
+		building_rules_.merge(prepared);
+		global_rules_prepared_ = false;
+	} else if(building_rules_.empty() && rules_cfg_) {
+		load_profiler::scope profile_rules("global rules");
 		// off_map first to prevent some default rule seems to block it
 		add_off_map_rule(offmap_image);
 		// parse global terrain rules
@@ -262,8 +299,29 @@ terrain_builder::terrain_builder(const config& level, const gamemap* m, const st
 	// parse local rules
 	parse_config(level);
 
-	if(m)
+	if(m) {
+		load_profiler::scope profile_build("build_terrains");
 		build_terrains();
+	}
+}
+
+terrain_builder::terrain_builder()
+	: tilewidth_(game_config::tile_size)
+	, map_(nullptr)
+	, tile_map_(0, 0)
+	, terrain_by_type_()
+	, draw_border_(false)
+{
+	image::precache_file_existence("terrain/");
+	parse_global_config(*rules_cfg_);
+	global_rules_prepared_ = true;
+}
+
+void terrain_builder::prepare_global_rules()
+{
+	if(global_rules_pending()) {
+		terrain_builder parser;
+	}
 }
 
 void terrain_builder::rebuild_cache_all()
@@ -286,13 +344,24 @@ void terrain_builder::flush_local_rules()
 	}
 }
 
-void terrain_builder::set_terrain_rules_cfg(const game_config_view& cfg)
+void terrain_builder::set_terrain_rules_cfg(const game_config_view& cfg, const std::string& rules_key)
 {
 	rules_cfg_ = &cfg;
+
+	// Parsing the rules is the expensive part of building the first map, don't
+	// throw them away when the game config is reloaded with the same rules.
+	if(!building_rules_.empty() && !rules_key.empty() && rules_key == rules_key_) {
+		LOG_TB << "terrain rules unchanged, keeping " << building_rules_.size() << " parsed rules";
+		return;
+	}
+
+	rules_key_ = rules_key;
+
 	// use the swap trick to clear the rules cache and get a fresh one.
 	// because simple clear() seems to cause some progressive memory degradation.
 	building_ruleset empty;
 	std::swap(building_rules_, empty);
+	global_rules_prepared_ = false;
 }
 
 void terrain_builder::reload_map()
@@ -838,9 +907,41 @@ void terrain_builder::parse_mapstring(
 	}
 }
 
+unsigned terrain_builder::intern_flag(const std::string& name)
+{
+	auto [it, inserted] = flag_ids_.emplace(name, flag_names_.size());
+	if(inserted) {
+		flag_names_.push_back(name);
+	}
+	return it->second;
+}
+
+void terrain_builder::intern_flags(building_rule& rule)
+{
+	auto intern_all = [](const std::vector<std::string>& names, std::vector<unsigned>& ids) {
+		ids.clear();
+		for(const std::string& name : names) {
+			ids.push_back(intern_flag(name));
+		}
+	};
+
+	for(terrain_constraint& cons : rule.constraints) {
+		intern_all(cons.set_flag, cons.set_flag_ids);
+		intern_all(cons.no_flag, cons.no_flag_ids);
+		intern_all(cons.has_flag, cons.has_flag_ids);
+
+		for(rule_image& img : cons.images) {
+			for(rule_image_variant& variant : img.variants) {
+				intern_all(variant.has_flag, variant.has_flag_ids);
+			}
+		}
+	}
+}
+
 void terrain_builder::add_rule(building_ruleset& rules, building_rule& rule)
 {
 	if(load_images(rule)) {
+		intern_flags(rule);
 		rules.insert(rule);
 	}
 }
@@ -1017,6 +1118,13 @@ void terrain_builder::add_off_map_rule(const std::string& image)
 bool terrain_builder::rule_matches(const terrain_builder::building_rule& rule,
 		const map_location& loc,
 		const terrain_constraint* type_checked) const
+{
+	return rule_terrain_matches(rule, loc, type_checked) && rule_flags_match(rule, loc);
+}
+
+bool terrain_builder::rule_terrain_matches(const terrain_builder::building_rule& rule,
+		const map_location& loc,
+		const terrain_constraint* type_checked) const
 {
 	// Don't match if the location isn't a multiple of mod_x and mod_y
 	if(rule.modulo_constraints.x > 0 && (loc.x % rule.modulo_constraints.x != 0)) {
@@ -1045,24 +1153,29 @@ bool terrain_builder::rule_matches(const terrain_builder::building_rule& rule,
 			return false;
 		}
 
-		// std::cout << "testing..." << builder_letter(map().get_terrain(tloc))
-
 		// check if terrain matches except if we already know that it does
 		if(&cons != type_checked && !terrain_matches(map().get_terrain(tloc), cons.terrain_types_match)) {
 			return false;
 		}
+	}
+
+	return true;
+}
 
-		const std::set<std::string>& flags = tile_map_[tloc].flags;
+bool terrain_builder::rule_flags_match(const terrain_builder::building_rule& rule, const map_location& loc) const
+{
+	for(const terrain_constraint& cons : rule.constraints) {
+		const tile& btile = tile_map_[legacy_sum(loc, cons.loc)];
 
-		for(const std::string& s : cons.no_flag) {
+		for(unsigned id : cons.no_flag_ids) {
 			// If a flag listed in "no_flag" is present, the rule does not match
-			if(flags.find(s) != flags.end()) {
+			if(btile.has_flag(id)) {
 				return false;
 			}
 		}
-		for(const std::string& s : cons.has_flag) {
+		for(unsigned id : cons.has_flag_ids) {
 			// If a flag listed in "has_flag" is not present, this rule does not match
-			if(flags.find(s) == flags.end()) {
+			if(!btile.has_flag(id)) {
 				return false;
 			}
 		}
@@ -1090,8 +1203,8 @@ void terrain_builder::apply_rule(const terrain_builder::building_rule& rule, con
 		}
 
 		// Sets flags
-		for(const std::string& flag : constraint.set_flag) {
-			btile.flags.insert(flag);
+		for(unsigned id : constraint.set_flag_ids) {
+			btile.set_flag(id);
 		}
 	}
 }
@@ -1132,6 +1245,9 @@ void terrain_builder::build_terrains()
 {
 	log_scope("terrain_builder::build_terrains");
 
+	const unsigned border_flag = intern_flag("_border");
+	const unsigned board_flag = intern_flag("_board");
+
 	// Builds the terrain_by_type_ cache
 	for(int x = -2; x <= map().w(); ++x) {
 		for(int y = -2; y <= map().h(); ++y) {
@@ -1143,13 +1259,19 @@ void terrain_builder::build_terrains()
 			// Flag all hexes according to whether they're on the border or not,
 			// to make it easier for WML to draw the borders
 			if(draw_border_&& !map().on_board(loc)) {
-				tile_map_[loc].flags.insert("_border");
+				tile_map_[loc].set_flag(border_flag);
 			} else {
-				tile_map_[loc].flags.insert("_board");
+				tile_map_[loc].set_flag(board_flag);
 			}
 		}
 	}
 
+	// Matching threads for the rules with many candidates, started when the
+	// first such rule is found and shared by all of them. The calling thread
+	// matches its own share of the candidates too.
+	const std::size_t threads = parallel_matching_ ? std::thread::hardware_concurrency() : 1;
+	std::optional<boost::asio::thread_pool> pool;
+
 	for(const building_rule& rule : building_rules_) {
 		// Find the constraint that contains the less terrain of all terrain rules.
 		// We will keep a track of the matching terrains of this constraint
@@ -1193,6 +1315,15 @@ void terrain_builder::build_terrains()
 
 		assert(min_constraint != nullptr);
 
+		if(min_size >= min_parallel_candidates && threads > 1) {
+			if(!pool) {
+				pool.emplace(threads - 1);
+			}
+
+			apply_rule_parallel(rule, min_types, min_constraint, *pool, threads);
+			continue;
+		}
+
 		// NOTE: if min_types is not empty, we have found a valid min_constraint;
 		for(t_translation::ter_list::const_iterator t = min_types.begin(); t != min_types.end(); ++t) {
 			const std::vector<map_location>* locations = &terrain_by_type_[*t];
@@ -1208,6 +1339,53 @@ void terrain_builder::build_terrains()
 	}
 }
 
+void terrain_builder::apply_rule_parallel(const building_rule& rule,
+		const t_translation::ter_list& types, const terrain_constraint* type_checked,
+		boost::asio::thread_pool& pool, std::size_t threads)
+{
+	std::vector<map_location> candidates;
+	for(const t_translation::terrain_code& t : types) {
+		for(const map_location& loc : terrain_by_type_[t]) {
+			candidates.push_back(legacy_difference(loc, type_checked->loc));
+		}
+	}
+
+	// The hash is computed lazily, do it before the workers share the rule.
+	rule.get_hash();
+
+	// Matching the terrain only reads the map, so it can be done for all
+	// candidates at once. Flags depend on the rules applied before, including
+	// this one at earlier candidates, so they are checked and applied in order
+	// afterwards, which keeps the result identical to the serial builder.
+	std::vector<char> terrain_ok(candidates.size());
+	auto match_range = [&](std::size_t begin, std::size_t end) {
+		for(std::size_t i = begin; i < end; ++i) {
+			terrain_ok[i] = rule_terrain_matches(rule, candidates[i], type_checked);
+		}
+	};
+
+	const std::size_t chunks = std::min(threads, candidates.size() / (min_parallel_candidates / 2));
+	const std::size_t chunk = (candidates.size() + chunks - 1) / chunks;
+
+	std::vector<std::future<void>> jobs;
+	for(std::size_t begin = chunk; begin < candidates.size(); begin += chunk) {
+		const std::size_t end = std::min(begin + chunk, candidates.size());
+		std::packaged_task<void()> job([&match_range, begin, end] { match_range(begin, end); });
+		jobs.push_back(job.get_future());
+		boost::asio::post(pool, std::move(job));
+	}
+	match_range(0, std::min(chunk, candidates.size()));
+	for(std::future<void>& job : jobs) {
+		job.get();
+	}
+
+	for(std::size_t i = 0; i < candidates.size(); ++i) {
+		if(terrain_ok[i] && rule_flags_match(rule, candidates[i])) {
+			apply_rule(rule, candidates[i]);
+		}
+	}
+}
+
 terrain_builder::tile* terrain_builder::get_tile(const map_location& loc)
 {
 	if(tile_map_.on_map(loc))
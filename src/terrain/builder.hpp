@@ -24,6 +24,10 @@
 #include "map/location.hpp"
 #include "terrain/translation.hpp"
 
+#include <boost/dynamic_bitset.hpp>
+
+#include <algorithm>
+
 class config;
 class game_config_view;
 
@@ -32,6 +36,10 @@ namespace image
 {
 class locator;
 }
+namespace boost::asio
+{
+class thread_pool;
+}
 /**
  * The class terrain_builder is constructed from a config object, and a
  * gamemap object. On construction, it parses the configuration and extracts
@@ -89,12 +97,40 @@ public:
 	terrain_builder(const config& level, const gamemap* map, const std::string& offmap_image, bool draw_border);
 
 	/**  Set the config where we will parse the global terrain rules.
-	 *   This also flushes the terrain rules cache.
+	 *   This also flushes the terrain rules cache, unless @a rules_key is the
+	 *   same as the one the cached rules were parsed with.
 	 *
 	 * @param cfg			The main game configuration object, where the
 	 *						[terrain_graphics] rule reside.
+	 * @param rules_key		Identifies the rules and binary paths of @a cfg,
+	 *						and changes whenever they might. Empty if
+	 *						unknown, which always flushes the cache.
+	 */
+	static void set_terrain_rules_cfg(const game_config_view& cfg, const std::string& rules_key = std::string());
+
+	/** Whether the next terrain_builder will have to parse the global terrain rules. */
+	static bool global_rules_pending()
+	{
+		return building_rules_.empty() && rules_cfg_;
+	}
+
+	/**
+	 * Parses the global terrain rules ahead of the next terrain_builder, if
+	 * they are not cached yet. This only reads the game config and checks which
+	 * images exist, so it may run on another thread, as long as no
+	 * terrain_builder is created and the rules config isn't changed meanwhile.
+	 */
+	static void prepare_global_rules();
+
+	/**
+	 * Sets whether rules with many candidate locations have their terrain
+	 * matched on several threads. On by default. The result is the same
+	 * either way, which the unit tests check by building with both.
 	 */
-	static void set_terrain_rules_cfg(const game_config_view& cfg);
+	static void set_parallel_matching(bool enabled)
+	{
+		parallel_matching_ = enabled;
+	}
 
 	const gamemap& map() const
 	{
@@ -171,6 +207,7 @@ public:
 			, images()
 			, tods()
 			, has_flag()
+			, has_flag_ids()
 			, random_start(random_start)
 		{
 		}
@@ -216,6 +253,8 @@ public:
 		std::set<std::string> tods;
 
 		std::vector<std::string> has_flag;
+		/** Interned ids of has_flag, see terrain_builder::intern_flags(). */
+		std::vector<unsigned> has_flag_ids;
 
 		/** Specify the allowed amount of random shift (in milliseconds) applied
 		 * to the animation start time, -1 for shifting without limitation.*/
@@ -283,6 +322,9 @@ public:
 			, set_flag()
 			, no_flag()
 			, has_flag()
+			, set_flag_ids()
+			, no_flag_ids()
+			, has_flag_ids()
 			, no_draw()
 			, images()
 		{
@@ -294,6 +336,9 @@ public:
 			, set_flag()
 			, no_flag()
 			, has_flag()
+			, set_flag_ids()
+			, no_flag_ids()
+			, has_flag_ids()
 			, no_draw()
 			, images()
 		{
@@ -305,6 +350,14 @@ public:
 		std::vector<std::string> no_flag;
 		std::vector<std::string> has_flag;
 
+		/**
+		 * Interned ids of the flags above, which are what the builder actually
+		 * uses. Filled in by terrain_builder::intern_flags() once the rule is final.
+		 */
+		std::vector<unsigned> set_flag_ids;
+		std::vector<unsigned> no_flag_ids;
+		std::vector<unsigned> has_flag_ids;
+
 		/** Whether to actually draw the images onto this hex or not */
 		bool no_draw;
 
@@ -337,8 +390,24 @@ public:
 		/** Clears all data in this tile, and resets the cache */
 		void clear();
 
-		/** The list of flags present in this tile */
-		std::set<std::string> flags;
+		/** The flags present in this tile, indexed by their interned id */
+		boost::dynamic_bitset<> flags;
+
+		bool has_flag(unsigned id) const
+		{
+			return id < flags.size() && flags.test(id);
+		}
+
+		void set_flag(unsigned id)
+		{
+			if(id >= flags.size()) {
+				flags.resize(std::max<std::size_t>(id + 1, flag_names_.size()));
+			}
+			flags.set(id);
+		}
+
+		/** The names of the flags present in this tile, sorted */
+		std::vector<std::string> flag_names() const;
 
 		/** Represent a rule_image applied with a random seed.*/
 		struct rule_image_rand
@@ -817,6 +886,18 @@ private:
 	 */
 	bool rule_matches(const building_rule& rule, const map_location& loc, const terrain_constraint* type_checked) const;
 
+	/**
+	 * The part of rule_matches() that only depends on the map: location,
+	 * probability and terrain constraints. Safe to call from several threads.
+	 */
+	bool rule_terrain_matches(const building_rule& rule, const map_location& loc, const terrain_constraint* type_checked) const;
+
+	/**
+	 * The part of rule_matches() that depends on the flags set by the rules
+	 * applied so far. @a loc must already have passed rule_terrain_matches().
+	 */
+	bool rule_flags_match(const building_rule& rule, const map_location& loc) const;
+
 	/**
 	 * Applies a rule at a given location: applies the result of a
 	 * matching rule at a given location: attachs the images corresponding
@@ -833,6 +914,17 @@ private:
 	 */
 	void build_terrains();
 
+	/** Rules with at least this many candidate locations have their terrain matched in parallel. */
+	static const std::size_t min_parallel_candidates = 4096;
+
+	/**
+	 * Applies a rule at all candidate locations of the given terrain types,
+	 * matching the terrain on the threads of @a pool. The result is the same
+	 * as checking and applying the candidates one by one.
+	 */
+	void apply_rule_parallel(const building_rule& rule, const t_translation::ter_list& types,
+			const terrain_constraint* type_checked, boost::asio::thread_pool& pool, std::size_t threads);
+
 	/**
 	 * A pointer to the gamemap class used in the current level.
 	 */
@@ -861,6 +953,35 @@ private:
 	/** Parsed terrain rules. Cached between instances */
 	static inline building_ruleset building_rules_{};
 
+	/**
+	 * Whether building_rules_ were parsed by prepare_global_rules(), and still
+	 * lack the off map rule, which needs the theme of the next builder.
+	 */
+	static inline bool global_rules_prepared_ = false;
+
+	/** Constructor only parsing the global rules, for prepare_global_rules(). */
+	terrain_builder();
+
+	/**
+	 * Every flag name used so far, indexed by its interned id.
+	 * Flags are stored as bits in the tiles, since matching rules tests and
+	 * sets them millions of times per map build.
+	 */
+	static inline std::vector<std::string> flag_names_{};
+	static inline std::map<std::string, unsigned> flag_ids_{};
+
+	/** Returns the interned id of a flag, adding it if needed. */
+	static unsigned intern_flag(const std::string& name);
+
+	/** Fills in the interned flag ids of a rule whose flag names are final. */
+	static void intern_flags(building_rule& rule);
+
 	/** Config used to parse global terrain rules */
 	static const inline game_config_view* rules_cfg_ = nullptr;
+
+	/** See set_parallel_matching(). */
+	static inline bool parallel_matching_ = true;
+
+	/** The key the cached global rules were parsed with, see set_terrain_rules_cfg(). */
+	static inline std::string rules_key_;
 };
@@ -25,7 +25,8 @@
 #include "log.hpp"
 #include "terrain/translation.hpp"
 #include "serialization/string_utils.hpp"
-#include "utils/iterable_pair.hpp" //equal_range returns a std:pair instead of sometihng iterable for some reason.
+
+#include <algorithm>
 
 #define ERR_G LOG_STREAM(err, lg::general())
 #define WRN_G LOG_STREAM(warn, lg::general())
@@ -104,6 +105,16 @@ namespace t_translation {
 	 */
 	static std::string number_to_string_(terrain_code terrain, const std::vector<std::string>& start_position = std::vector<std::string>());
 
+	/**
+	 * Converts one cell of a game map to a terrain code, the same way as
+	 * string_to_number_ with NO_LAYER as filler. Cells without a starting
+	 * position, nearly all of them, are converted in a single pass.
+	 */
+	static terrain_code read_map_cell_(std::string_view str, std::vector<std::string>& start_positions);
+
+	/** Appends the string of a terrain code, without starting positions, to @a out. */
+	static void append_terrain_code_(std::string& out, terrain_code terrain);
+
 	/**
 	 * Converts a terrain string to a number for the builder.
 	 * The translation rules differ from the normal conversion rules
@@ -306,17 +317,22 @@ ter_map read_game_map(std::string_view str, starting_positions& starting_positio
 	auto map_size = get_map_size(&str[0], &str[0] + str.size());
 	ter_map result(map_size.first, map_size.second);
 
+	std::vector<std::string> sp;
 	while(offset < str.length()) {
 
 		// Get a terrain chunk
-		const std::string separators = ",\n\r";
-		const std::size_t pos_separator = str.find_first_of(separators, offset);
+		std::size_t pos_separator = offset;
+		while(pos_separator < str.length() && str[pos_separator] != ',' && !utils::isnewline(str[pos_separator])) {
+			++pos_separator;
+		}
+		if(pos_separator == str.length()) {
+			pos_separator = std::string::npos;
+		}
 		std::string_view terrain = str.substr(offset, pos_separator - offset);
 
 		// Process the chunk
-		std::vector<std::string> sp;
 		// The gamemap never has a wildcard
-		const terrain_code tile = string_to_number_(terrain, sp, NO_LAYER);
+		const terrain_code tile = read_map_cell_(terrain, sp);
 
 		// Add to the resulting starting position
 		for(const auto& starting_position : sp) {
@@ -325,6 +341,7 @@ ter_map read_game_map(std::string_view str, starting_positions& starting_positio
 			}
 			starting_positions.insert(starting_positions::value_type(starting_position, coordinate(x - border_offset.x, y - border_offset.y)));
 		}
+		sp.clear();
 
 		if(result.w <= x || result.h <= y) {
 			throw error("Map not a rectangle.");
@@ -388,32 +405,52 @@ ter_map read_game_map(std::string_view str, starting_positions& starting_positio
 
 std::string write_game_map(const ter_map& map, const starting_positions& starting_positions, coordinate border_offset)
 {
-	std::stringstream str;
+	// The starting positions on the map, in the order they are written.
+	// Those of the same location are written last to first.
+	std::vector<std::pair<std::size_t, const std::string*>> sp;
+	for(const auto& pair : starting_positions.right) {
+		const int x = pair.first.x + border_offset.x;
+		const int y = pair.first.y + border_offset.y;
+		if(x >= 0 && y >= 0 && x < map.w && y < map.h) {
+			sp.emplace_back(static_cast<std::size_t>(y) * map.w + x, &pair.second);
+		}
+	}
+	std::stable_sort(sp.begin(), sp.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
 
+	// Most cells are a 2 to 6 character code and the ", " separator.
+	std::string str;
+	str.reserve(static_cast<std::size_t>(map.w) * map.h * 8 + map.h);
+
+	auto next_sp = sp.begin();
 	for(int y = 0; y < map.h; ++y) {
 		for(int x = 0; x < map.w; ++x) {
+			// Add the separator
+			if(x != 0) {
+				str += ", ";
+			}
 
 			// If the current location is a starting position,
 			// it needs to be added to the terrain.
-			// After it's found it can't be found again,
-			// so the location is removed from the map.
-			std::vector<std::string> sp;
-
-			for(const auto& pair : starting_positions.right.equal_range(coordinate(x - border_offset.x, y - border_offset.y))) {
-				sp.push_back(pair.second);
+			const std::size_t index = static_cast<std::size_t>(y) * map.w + x;
+			auto sp_end = next_sp;
+			while(sp_end != sp.end() && sp_end->first == index) {
+				++sp_end;
 			}
-			// Add the separator
-			if(x != 0) {
-				str << ", ";
+			for(auto it = sp_end; it != next_sp;) {
+				--it;
+				str += *it->second;
+				str += ' ';
 			}
-			str << number_to_string_(map[x][y], sp);
+			next_sp = sp_end;
+
+			append_terrain_code_(str, map[x][y]);
 		}
 
 		if (y < map.h -1)
-			str << "\n";
+			str += '\n';
 	}
 
-	return str.str();
+	return str;
 }
 
 bool terrain_matches(const terrain_code& src, const terrain_code& dest)
@@ -772,6 +809,40 @@ static terrain_code string_to_number_(std::string_view str, std::vector<std::str
 	return result;
 }
 
+static terrain_code read_map_cell_(std::string_view str, std::vector<std::string>& start_positions)
+{
+	// Same as utils::trim, without the generic searches for the one space most cells have.
+	const auto is_space = [](char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; };
+	while(!str.empty() && is_space(str.front())) {
+		str.remove_prefix(1);
+	}
+	while(!str.empty() && is_space(str.back())) {
+		str.remove_suffix(1);
+	}
+
+	std::size_t caret = std::string_view::npos;
+	for(std::size_t i = 0; i < str.size(); ++i) {
+		if(str[i] == ' ') {
+			// Starting positions are rare, leave them to the general conversion.
+			return string_to_number_(str, start_positions, NO_LAYER);
+		}
+
+		if(str[i] == '^' && caret == std::string_view::npos) {
+			caret = i;
+		}
+	}
+
+	if(str.empty()) {
+		return terrain_code();
+	}
+
+	if(caret == std::string_view::npos) {
+		return terrain_code { string_to_layer_(str), NO_LAYER };
+	}
+
+	return terrain_code { string_to_layer_(str.substr(0, caret)), string_to_layer_(str.substr(caret + 1)) };
+}
+
 static std::string number_to_string_(terrain_code terrain, const std::vector<std::string>& start_positions)
 {
 	std::string result = "";
@@ -781,6 +852,12 @@ static std::string number_to_string_(terrain_code terrain, const std::vector<std
 		result = str + " " + result;
 	}
 
+	append_terrain_code_(result, terrain);
+	return result;
+}
+
+static void append_terrain_code_(std::string& result, terrain_code terrain)
+{
 	/*
 	 * The initialization of tcode is done to make gcc-4.7 happy. Otherwise it
 	 * some uninitialized fields might be used. Its analysis are wrong, but
@@ -814,8 +891,6 @@ static std::string number_to_string_(terrain_code terrain, const std::vector<std
 			break;
 		}
 	}
-
-	return result;
 }
 
 static terrain_code string_to_builder_number_(std::string str)
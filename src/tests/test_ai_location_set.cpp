@@ -0,0 +1,139 @@
+/*
+	Copyright (C) 2024 - 2024
+	by the Battle for Wesnoth developers
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#define GETTEXT_DOMAIN "wesnoth-test"
+
+#include <boost/test/unit_test.hpp>
+
+#include "ai/lua/location_set.hpp"
+
+#include <algorithm>
+#include <random>
+
+using ai::location_set;
+
+namespace
+{
+location_set set_of(std::vector<map_location> locs)
+{
+	return location_set(std::move(locs));
+}
+
+/** A set with every other location of a @a size x @a size square, shifted by @a offset. */
+location_set checkerboard(int size, int offset)
+{
+	std::vector<map_location> locs;
+	for(int x = 0; x < size; ++x) {
+		for(int y = 0; y < size; ++y) {
+			if((x + y + offset) % 2 == 0) {
+				locs.emplace_back(x, y);
+			}
+		}
+	}
+	// The constructor sorts its input.
+	std::reverse(locs.begin(), locs.end());
+	return location_set(std::move(locs));
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(ai_location_set)
+
+BOOST_AUTO_TEST_CASE(test_set_operations)
+{
+	const location_set a = set_of({map_location(1, 1), map_location(0, 0), map_location(2, 3), map_location(0, 0)});
+	const location_set b(std::set<map_location>{map_location(2, 3), map_location(4, 4)});
+
+	BOOST_CHECK_EQUAL(a.size(), 3);
+	BOOST_CHECK(a.contains(map_location(1, 1)));
+	BOOST_CHECK(!a.contains(map_location(4, 4)));
+	BOOST_CHECK(std::is_sorted(a.begin(), a.end()));
+
+	BOOST_CHECK(a.union_with(b) == set_of({map_location(0, 0), map_location(1, 1), map_location(2, 3), map_location(4, 4)}));
+	BOOST_CHECK(a.intersection(b) == set_of({map_location(2, 3)}));
+	BOOST_CHECK(a.difference(b) == set_of({map_location(0, 0), map_location(1, 1)}));
+	BOOST_CHECK(b.difference(a) == set_of({map_location(4, 4)}));
+
+	const location_set even = checkerboard(10, 0);
+	const location_set odd = checkerboard(10, 1);
+	BOOST_CHECK_EQUAL(even.union_with(odd).size(), 100);
+	BOOST_CHECK(even.intersection(odd).empty());
+	BOOST_CHECK(even.difference(odd) == even);
+	BOOST_CHECK(even.union_with(odd).difference(odd) == even);
+}
+
+BOOST_AUTO_TEST_CASE(test_distance_map_matches_distance_between)
+{
+	std::mt19937 rng(1234);
+
+	for(int sample = 0; sample < 20; ++sample) {
+		const int width = std::uniform_int_distribution<int>(1, 20)(rng);
+		const int height = std::uniform_int_distribution<int>(1, 20)(rng);
+		std::uniform_int_distribution<int> x_dist(-1, width);
+		std::uniform_int_distribution<int> y_dist(-1, height);
+
+		std::vector<map_location> locs;
+		for(int i = 0; i < 3; ++i) {
+			locs.emplace_back(x_dist(rng), y_dist(rng));
+		}
+		const location_set sources(std::move(locs));
+
+		const auto distances = ai::distance_map(width, height, sources, -1);
+
+		std::vector<int> expected;
+		for(int x = 0; x < width; ++x) {
+			for(int y = 0; y < height; ++y) {
+				int nearest = -1;
+				for(const map_location& src : sources) {
+					if(src.valid(width, height)) {
+						const int d = distance_between(src, map_location(x, y));
+						nearest = nearest < 0 ? d : std::min(nearest, d);
+					}
+				}
+				if(nearest >= 0) {
+					expected.push_back(nearest);
+				}
+			}
+		}
+
+		BOOST_REQUIRE_EQUAL(distances.size(), expected.size());
+		for(std::size_t i = 0; i < distances.size(); ++i) {
+			const auto& [loc, distance] = distances[i];
+			BOOST_REQUIRE(loc.valid(width, height));
+			BOOST_CHECK_EQUAL(distance, expected[loc.x * height + loc.y]);
+			if(i > 0) {
+				BOOST_CHECK(distances[i - 1].second <= distance);
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_distance_map_max_distance)
+{
+	const location_set sources = set_of({map_location(5, 5)});
+
+	const auto within_two = ai::distance_map(11, 11, sources, 2);
+	// The source, its 6 neighbours and the 12 hexes two away.
+	BOOST_CHECK_EQUAL(within_two.size(), 19);
+	for(const auto& [loc, distance] : within_two) {
+		BOOST_CHECK_EQUAL(distance, static_cast<int>(distance_between(loc, map_location(5, 5))));
+		BOOST_CHECK(distance <= 2);
+	}
+
+	BOOST_CHECK_EQUAL(ai::distance_map(11, 11, sources, 0).size(), 1);
+	BOOST_CHECK(ai::distance_map(11, 11, set_of({map_location(11, 0)}), -1).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,126 @@
+/*
+	Copyright (C) 2024 - 2024
+	by the Battle for Wesnoth developers
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#define GETTEXT_DOMAIN "wesnoth-test"
+
+#include <boost/test/unit_test.hpp>
+
+#include "ai/default/ca.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+using ai::ai_default_rca::match_units_to_villages;
+
+namespace
+{
+using reach_matrix = std::vector<boost::dynamic_bitset<>>;
+
+/**
+ * The most villages that can be captured, found by trying every permutation
+ * the way get_villages_phase::dispatch_complex used to.
+ */
+std::size_t best_by_permutations(const reach_matrix& reach, std::size_t village_count)
+{
+	std::vector<std::size_t> perm(std::max(reach.size(), village_count));
+	std::iota(perm.begin(), perm.end(), 0);
+
+	std::size_t best = 0;
+	do {
+		std::size_t captured = 0;
+		for(std::size_t u = 0; u < reach.size(); ++u) {
+			if(perm[u] < village_count && reach[u][perm[u]]) {
+				++captured;
+			}
+		}
+		best = std::max(best, captured);
+	} while(std::next_permutation(perm.begin(), perm.end()));
+
+	return best;
+}
+
+/** Checks that @a village_unit is a valid dispatch and returns the number of villages taken. */
+std::size_t count_dispatched(const reach_matrix& reach, const std::vector<std::size_t>& village_unit)
+{
+	std::vector<bool> used(reach.size());
+	std::size_t dispatched = 0;
+	for(std::size_t v = 0; v < village_unit.size(); ++v) {
+		const std::size_t u = village_unit[v];
+		if(u == reach.size()) {
+			continue;
+		}
+
+		BOOST_REQUIRE(u < reach.size());
+		BOOST_CHECK(reach[u][v]);
+		BOOST_CHECK(!used[u]);
+		used[u] = true;
+		++dispatched;
+	}
+
+	return dispatched;
+}
+
+std::vector<std::size_t> in_order(std::size_t unit_count)
+{
+	std::vector<std::size_t> order(unit_count);
+	std::iota(order.begin(), order.end(), 0);
+	return order;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(ai_villages)
+
+BOOST_AUTO_TEST_CASE(test_match_moves_earlier_units)
+{
+	// Unit 0 takes village 0 first, but it is the only village unit 1 can
+	// reach, so unit 0 must be moved to village 1.
+	reach_matrix reach(2, boost::dynamic_bitset<>(2));
+	reach[0][0] = reach[0][1] = true;
+	reach[1][0] = true;
+
+	const auto village_unit = match_units_to_villages(reach, 2, in_order(2));
+	BOOST_CHECK_EQUAL(count_dispatched(reach, village_unit), 2);
+	BOOST_CHECK_EQUAL(village_unit[0], 1);
+	BOOST_CHECK_EQUAL(village_unit[1], 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_match_same_as_permutations)
+{
+	std::mt19937 rng(1234);
+	std::bernoulli_distribution reachable(0.4);
+
+	for(std::size_t unit_count = 1; unit_count <= 6; ++unit_count) {
+		for(std::size_t village_count = 1; village_count <= 6; ++village_count) {
+			for(int sample = 0; sample < 20; ++sample) {
+				reach_matrix reach(unit_count, boost::dynamic_bitset<>(village_count));
+				for(auto& villages : reach) {
+					for(std::size_t v = 0; v < village_count; ++v) {
+						villages[v] = reachable(rng);
+					}
+				}
+
+				std::vector<std::size_t> order = in_order(unit_count);
+				std::shuffle(order.begin(), order.end(), rng);
+
+				const auto village_unit = match_units_to_villages(reach, village_count, order);
+				BOOST_CHECK_EQUAL(count_dispatched(reach, village_unit), best_by_permutations(reach, village_count));
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,172 @@
+/*
+	Copyright (C) 2024 - 2024
+	by the Battle for Wesnoth developers
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#define GETTEXT_DOMAIN "wesnoth-test"
+
+#include <boost/test/unit_test.hpp>
+
+#include "filesystem.hpp"
+#include "persist_context.hpp"
+
+namespace
+{
+const std::string test_root = "test_persist_context";
+
+std::string persist_file(const std::string& extension)
+{
+	return filesystem::get_dir(filesystem::get_user_data_dir() + "/persist/") + test_root + extension;
+}
+
+/** Removes the files of the test namespace before and after each test. */
+struct persist_fixture
+{
+	persist_fixture()
+	{
+		remove_files();
+	}
+
+	~persist_fixture()
+	{
+		remove_files();
+	}
+
+	static void remove_files()
+	{
+		for(const char* extension : {".dat", ".dat.new", ".cfg"}) {
+			if(filesystem::file_exists(persist_file(extension))) {
+				filesystem::delete_file(persist_file(extension));
+			}
+		}
+	}
+};
+
+config array_of(const std::string& name, const std::vector<std::string>& values)
+{
+	config array;
+	for(const std::string& value : values) {
+		array.add_child(name)["value"] = value;
+	}
+	return array;
+}
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(persist_context_suite, persist_fixture)
+
+BOOST_AUTO_TEST_CASE(test_round_trip)
+{
+	{
+		persist_file_context ctx(test_root + ".campaign");
+		BOOST_CHECK(ctx.set_var("gold", pack_scalar("gold", "100")));
+		BOOST_CHECK(ctx.set_var("heroes", array_of("heroes", {"Konrad", "Delfador"})));
+	}
+
+	BOOST_CHECK(filesystem::file_exists(persist_file(".dat")));
+
+	persist_file_context ctx(test_root + ".campaign");
+	BOOST_CHECK_EQUAL(ctx.get_var("gold")["gold"].str(), "100");
+	BOOST_CHECK_EQUAL(ctx.get_var("heroes"), array_of("heroes", {"Konrad", "Delfador"}));
+	BOOST_CHECK_EQUAL(ctx.get_var("missing")["missing"].str(), "");
+
+	// Other nodes of the same file don't see the variables.
+	persist_file_context other(test_root + ".other");
+	BOOST_CHECK_EQUAL(other.get_var("gold")["gold"].str(), "");
+
+	BOOST_CHECK(ctx.clear_var("gold"));
+	BOOST_CHECK(!ctx.clear_var("gold"));
+	BOOST_CHECK_EQUAL(persist_file_context(test_root + ".campaign").get_var("gold")["gold"].str(), "");
+}
+
+BOOST_AUTO_TEST_CASE(test_clear_array_element)
+{
+	persist_file_context ctx(test_root);
+	BOOST_CHECK(ctx.set_var("heroes", array_of("heroes", {"Konrad", "Delfador", "Kalenz"})));
+
+	BOOST_CHECK(ctx.clear_var("heroes[1]"));
+	BOOST_CHECK_EQUAL(persist_file_context(test_root).get_var("heroes"), array_of("heroes", {"Konrad", "Kalenz"}));
+
+	BOOST_CHECK(!ctx.clear_var("heroes[2]"));
+	BOOST_CHECK(!ctx.clear_var("villains[0]"));
+
+	BOOST_CHECK(ctx.clear_var("heroes[0]"));
+	BOOST_CHECK(ctx.clear_var("heroes[0]"));
+	BOOST_CHECK(!persist_file_context(test_root).get_var("heroes").has_child("heroes"));
+}
+
+BOOST_AUTO_TEST_CASE(test_legacy_import)
+{
+	const std::string legacy =
+		"[variables]\n"
+		"\tgold=50\n"
+		"[/variables]\n"
+		"[campaign]\n"
+		"\t[variables]\n"
+		"\t\tgold=100\n"
+		"\t\t[heroes]\n"
+		"\t\t\tvalue=\"Konrad\"\n"
+		"\t\t[/heroes]\n"
+		"\t[/variables]\n"
+		"[/campaign]\n";
+	filesystem::write_file(persist_file(".cfg"), legacy);
+
+	persist_file_context root(test_root);
+	BOOST_CHECK_EQUAL(root.get_var("gold")["gold"].str(), "50");
+
+	persist_file_context ctx(test_root + ".campaign");
+	BOOST_CHECK_EQUAL(ctx.get_var("gold")["gold"].str(), "100");
+	BOOST_CHECK_EQUAL(ctx.get_var("heroes"), array_of("heroes", {"Konrad"}));
+
+	// The old file is kept as it was, and not imported again.
+	BOOST_CHECK(filesystem::file_exists(persist_file(".dat")));
+	BOOST_CHECK_EQUAL(filesystem::read_file(persist_file(".cfg")), legacy);
+
+	BOOST_CHECK(ctx.set_var("gold", pack_scalar("gold", "200")));
+	BOOST_CHECK_EQUAL(persist_file_context(test_root + ".campaign").get_var("gold")["gold"].str(), "200");
+}
+
+BOOST_AUTO_TEST_CASE(test_immediate_in_transaction)
+{
+	persist_file_context ctx(test_root);
+	BOOST_CHECK(ctx.start_transaction());
+	BOOST_CHECK(ctx.set_var("pending", pack_scalar("pending", "1")));
+	BOOST_CHECK(ctx.set_var("immediate", pack_scalar("immediate", "2"), true));
+
+	// Only the immediate variable is written before the transaction ends.
+	persist_file_context reader(test_root);
+	BOOST_CHECK_EQUAL(reader.get_var("immediate")["immediate"].str(), "2");
+	BOOST_CHECK_EQUAL(reader.get_var("pending")["pending"].str(), "");
+
+	// Cancelling the transaction keeps it.
+	BOOST_CHECK(ctx.cancel_transaction());
+	BOOST_CHECK_EQUAL(ctx.get_var("pending")["pending"].str(), "");
+	BOOST_CHECK_EQUAL(ctx.get_var("immediate")["immediate"].str(), "2");
+	BOOST_CHECK_EQUAL(persist_file_context(test_root).get_var("immediate")["immediate"].str(), "2");
+}
+
+BOOST_AUTO_TEST_CASE(test_unknown_format_not_written)
+{
+	// The magic of the format, with a version this one doesn't know.
+	const std::string future_version("WPST\x02\0\0\0\0\0\0\0", 12);
+
+	for(const std::string& contents : {std::string("not a persistent variable file"), future_version}) {
+		filesystem::write_file(persist_file(".dat"), contents);
+
+		persist_file_context ctx(test_root);
+		BOOST_CHECK(!ctx.set_var("gold", pack_scalar("gold", "100")));
+		BOOST_CHECK_EQUAL(filesystem::read_file(persist_file(".dat")), contents);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
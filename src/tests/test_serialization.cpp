@@ -16,11 +16,13 @@
 #define GETTEXT_DOMAIN "wesnoth-test"
 
 #include <array>
+#include <chrono>
 #include <vector>
 #include <string>
 #include "serialization/base64.hpp"
 #include "serialization/string_utils.hpp"
 #include "serialization/unicode.hpp"
+#include "terrain/translation.hpp"
 #include <boost/test/unit_test.hpp>
 
 namespace std {
@@ -636,4 +638,56 @@ BOOST_AUTO_TEST_CASE( test_base64_encodings )
 	BOOST_CHECK(crypt64::decode(crypt64::encode({many_bytes.data(), many_bytes.size()})) == many_bytes);
 }
 
+BOOST_AUTO_TEST_CASE( test_game_map_strings )
+{
+	using namespace t_translation;
+
+	starting_positions positions;
+	ter_map map = read_game_map("\n Gg , 1 Gs^Fp\r\n2 player3 Ww,Chr^Ecf\n", positions);
+	BOOST_CHECK_EQUAL(map.w, 2);
+	BOOST_CHECK_EQUAL(map.h, 2);
+	BOOST_CHECK(map.get(0, 0) == terrain_code("Gg"));
+	BOOST_CHECK(map.get(1, 0) == terrain_code("Gs", "Fp"));
+	BOOST_CHECK(map.get(0, 1) == terrain_code("Ww"));
+	BOOST_CHECK(map.get(1, 1) == terrain_code("Chr", "Ecf"));
+	BOOST_CHECK_EQUAL(positions.size(), 3u);
+	BOOST_CHECK(positions.left.at("1") == coordinate(1, 0));
+	BOOST_CHECK(positions.left.at("player3") == coordinate(0, 1));
+	BOOST_CHECK_EQUAL(write_game_map(map, positions), "Gg, 1 Gs^Fp\nplayer3 2 Ww, Chr^Ecf");
+
+	BOOST_CHECK_THROW(read_game_map("Gg, Ww\nGg", positions), error);
+	BOOST_CHECK_THROW(read_game_map("Ggggg, Ww", positions), error);
+
+	// A 200x200 map with long overlay codes and a few starting positions,
+	// timed since every scenario, editor and mapgen map goes through here.
+	const std::array<std::string, 6> codes {"Gg", "Gs^Fp", "Chr^Ecf", "Mm^Xm", "Ds^Dr", "_off^_usr"};
+	std::string text;
+	for(int y = 0; y < 200; ++y) {
+		for(int x = 0; x < 200; ++x) {
+			if(x != 0) {
+				text += ", ";
+			}
+			if((x + y * 200) % 4999 == 0) {
+				text += std::to_string((x + y * 200) / 4999 + 1) + " ";
+			}
+			text += codes[(x * 13 + y * 7) % codes.size()];
+		}
+		text += '\n';
+	}
+	text.pop_back();
+
+	const auto start = std::chrono::steady_clock::now();
+	positions.clear();
+	map = read_game_map(text, positions);
+	const auto read = std::chrono::steady_clock::now();
+	const std::string written = write_game_map(map, positions);
+	const auto end = std::chrono::steady_clock::now();
+
+	BOOST_CHECK_EQUAL(positions.size(), 9u);
+	BOOST_CHECK(written == text);
+	BOOST_TEST_MESSAGE("200x200 map read in "
+		<< std::chrono::duration_cast<std::chrono::microseconds>(read - start).count() << "us, written in "
+		<< std::chrono::duration_cast<std::chrono::microseconds>(end - read).count() << "us");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -45,5 +45,46 @@ d="\"""
 	BOOST_CHECK((*test_node)["e"] == "f");
 }
 
+BOOST_AUTO_TEST_CASE( simple_wml_child_lookup )
+{
+	const char* doctext = R"([turn]
+	[command]
+		[move]
+			x="1,2"
+			y="1,1"
+		[/move]
+	[/command]
+	[command]
+		[attack]
+			weapon="0"
+		[/attack]
+	[/command]
+[/turn]
+[turns]
+	current="2"
+[/turns]
+[t]
+[/t]
+)";
+	simple_wml::document doc(doctext, INIT_STATE::INIT_COMPRESSED);
+
+	// Names that share a prefix or a length must not be confused.
+	const simple_wml::node* turn = doc.child("turn");
+	BOOST_REQUIRE(turn);
+	BOOST_CHECK(doc.child("turns"));
+	BOOST_CHECK((*doc.child("turns"))["current"] == "2");
+	BOOST_CHECK(doc.child("t"));
+	BOOST_CHECK(!doc.child("tur"));
+	BOOST_CHECK(!doc.child("tarn"));
+	BOOST_CHECK(!doc.child(""));
+
+	const simple_wml::node::child_list& commands = turn->children("command");
+	BOOST_REQUIRE_EQUAL(commands.size(), 2u);
+	BOOST_CHECK((*commands[0]->child("move"))["x"] == "1,2");
+	BOOST_CHECK((*commands[1]->child("attack"))["weapon"] == "0");
+	BOOST_CHECK(commands[0]->children("attack").empty());
+	BOOST_CHECK(turn->children("commands").empty());
+}
+
 /* vim: set ts=4 sw=4: */
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,144 @@
+/*
+	Copyright (C) 2024 - 2024
+	by the Battle for Wesnoth developers
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#define GETTEXT_DOMAIN "wesnoth-test"
+
+#include <boost/test/unit_test.hpp>
+
+#include "config.hpp"
+#include "map/map.hpp"
+#include "picture.hpp"
+#include "terrain/builder.hpp"
+#include "tests/utils/game_config_manager_tests.hpp"
+
+#include <algorithm>
+#include <tuple>
+
+namespace
+{
+/** A map of grass with scattered hills, large enough for the builder to match its rules in parallel. */
+std::string synthetic_map_data(int size)
+{
+	std::string data;
+	for(int y = 0; y < size; ++y) {
+		for(int x = 0; x < size; ++x) {
+			data += (x * 7 + y * 3) % 5 == 0 ? "Hh" : "Gg";
+			data += x + 1 < size ? ", " : "\n";
+		}
+	}
+	return data;
+}
+
+config tile(int x, int y, const std::string& type)
+{
+	config cfg;
+	cfg["x"] = x;
+	cfg["y"] = y;
+	cfg["type"] = type;
+	return cfg;
+}
+
+/**
+ * Rules whose result depends on the order the candidates are visited in:
+ * pairs of hexes claim each other with a flag, hexes left unclaimed get
+ * another flag, and some of those get an image.
+ */
+config synthetic_rules()
+{
+	config level;
+
+	config& pairs = level.add_child("terrain_graphics");
+	pairs["probability"] = 60;
+	pairs["set_no_flag"] = "paired";
+	pairs.add_child("tile", tile(0, 0, "Gg"));
+	pairs.add_child("tile", tile(0, 1, "Gg, Hh"));
+
+	config& singles = level.add_child("terrain_graphics");
+	singles["probability"] = 30;
+	config& single = singles.add_child("tile", tile(0, 0, "Gg"));
+	single["no_flag"] = "paired";
+	single["set_flag"] = "single";
+	single.add_child("image")["name"] = "grass/green";
+
+	return level;
+}
+
+/** What the builder put on a tile, in a form that outlives the builder's rules. */
+struct built_tile
+{
+	std::vector<std::string> flags;
+	std::vector<std::tuple<int, int, unsigned, std::string>> images;
+
+	bool operator==(const built_tile& other) const
+	{
+		return flags == other.flags && images == other.images;
+	}
+};
+
+std::vector<built_tile> build(const gamemap& map, const config& level, bool parallel)
+{
+	terrain_builder::set_parallel_matching(parallel);
+	terrain_builder builder(level, &map, "off-map/alpha", true);
+	terrain_builder::set_parallel_matching(true);
+
+	std::vector<built_tile> result;
+	for(int x = -2; x <= map.w() + 1; ++x) {
+		for(int y = -2; y <= map.h() + 1; ++y) {
+			const terrain_builder::tile* t = builder.get_tile(map_location(x, y));
+			BOOST_REQUIRE(t != nullptr);
+
+			built_tile& built = result.emplace_back();
+			built.flags = t->flag_names();
+			for(const terrain_builder::tile::rule_image_rand& image : t->images) {
+				built.images.emplace_back(image->layer, image->basey, image.rand, image->variants.front().image_string);
+			}
+		}
+	}
+	return result;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(terrain_builder_suite)
+
+BOOST_AUTO_TEST_CASE(test_parallel_build_matches_serial)
+{
+	// Sets up the binary paths, so that the builder can find terrain images.
+	test_utils::get_test_config_ref();
+
+	const gamemap map(synthetic_map_data(100));
+	const config level = synthetic_rules();
+
+	const std::vector<built_tile> serial = build(map, level, false);
+	const std::vector<built_tile> parallel = build(map, level, true);
+
+	BOOST_REQUIRE_EQUAL(serial.size(), parallel.size());
+	std::size_t differences = 0;
+	std::size_t paired = 0;
+	for(std::size_t i = 0; i < serial.size(); ++i) {
+		if(!(serial[i] == parallel[i])) {
+			++differences;
+		}
+		if(std::find(serial[i].flags.begin(), serial[i].flags.end(), "paired") != serial[i].flags.end()) {
+			++paired;
+		}
+	}
+
+	BOOST_CHECK_EQUAL(differences, 0);
+	// The rules did apply, so the comparison isn't between two empty builds.
+	BOOST_CHECK(paired > 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
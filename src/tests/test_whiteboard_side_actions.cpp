@@ -22,6 +22,8 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <set>
+
 using namespace wb;
 
 struct dummy_action: action{
@@ -129,4 +131,35 @@ BOOST_AUTO_TEST_CASE( test_removal )
 	}
 }
 
+BOOST_AUTO_TEST_CASE( test_revision )
+{
+	side_actions_container sac;
+	side_actions_container other;
+	BOOST_REQUIRE(sac.revision() != other.revision());
+
+	auto act1 = std::make_shared<dummy_action>(0, false, 1);
+	auto act2 = std::make_shared<dummy_action>(0, false, 2);
+
+	// Every modification of the queue must give it a revision never seen before.
+	std::set<std::size_t> seen {sac.revision(), other.revision()};
+	auto check_new_revision = [&]() { BOOST_REQUIRE(seen.insert(sac.revision()).second); };
+
+	side_actions::iterator it1 = sac.queue(0, act1);
+	check_new_revision();
+	sac.insert(sac.begin(), act2);
+	check_new_revision();
+	sac.bump_later(sac.begin());
+	check_new_revision();
+
+	// Lookups do not change anything.
+	const std::size_t before = sac.revision();
+	BOOST_REQUIRE(sac.turn_size(0) == 2);
+	BOOST_REQUIRE(sac.revision() == before);
+
+	sac.erase(it1);
+	check_new_revision();
+	sac.clear();
+	check_new_revision();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -32,6 +32,7 @@
 #include "game_events/manager.hpp" // for add_events
 #include "game_version.hpp"
 #include "lexical_cast.hpp"
+#include "load_profiler.hpp"
 #include "log.hpp"                       // for LOG_STREAM, logger, etc
 #include "map/map.hpp"                   // for gamemap
 #include "preferences/game.hpp"          // for encountered_units
@@ -397,6 +398,7 @@ unit::unit(unit_ctor_t)
 
 void unit::init(const config& cfg, bool use_traits, const vconfig* vcfg)
 {
+	load_profiler::scope profile("unit::init");
 	loc_ = map_location(cfg["x"], cfg["y"], wml_loc());
 	type_ = &get_unit_type(cfg["parent_type"].blank() ? cfg["type"].str() : cfg["parent_type"].str());
 	race_ = &unit_race::null_race;
@@ -703,6 +705,7 @@ void unit::clear_status_caches()
 
 void unit::init(const unit_type& u_type, int side, bool real_unit, unit_race::GENDER gender, const std::string& variation)
 {
+	load_profiler::scope profile("unit::init");
 	type_ = &u_type;
 	race_ = &unit_race::null_race;
 	variation_ = variation.empty() ? type_->default_variation() : variation;
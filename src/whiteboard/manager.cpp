@@ -70,6 +70,7 @@ manager::manager():
 		activation_state_lock_(new bool),
 		unit_map_lock_(new bool),
 		mapbuilder_(),
+		validity_cache_(new validity_cache),
 		highlighter_(),
 		route_(),
 		move_arrows_(),
@@ -445,6 +446,8 @@ void manager::validate_viewer_actions()
 {
 	LOG_WB << "'gamestate_mutated_' flag dirty, validating actions.";
 	gamestate_mutated_ = false;
+	// Explicit validation requests always validate every action again.
+	++validity_cache_->gamestate_revision;
 	if(has_planned_unit_map()) {
 		real_map();
 	} else {
@@ -615,6 +618,7 @@ void manager::on_gamestate_change()
 	assert(!planned_unit_map_active_);
 	// Set mutated flag so action queue gets validated on next future map build
 	gamestate_mutated_ = true;
+	++validity_cache_->gamestate_revision;
 	//Clear exclusive draws that might not get a chance to be cleared the normal way
 	display::get_singleton()->clear_exclusive_draws();
 }
@@ -1183,7 +1187,7 @@ void manager::set_planned_unit_map()
 	}
 
 	log_scope2(log_whiteboard, "Building planned unit map");
-	mapbuilder_.reset(new mapbuilder(resources::gameboard->units()));
+	mapbuilder_.reset(new mapbuilder(resources::gameboard->units(), validity_cache_.get()));
 	mapbuilder_->build_map();
 
 	planned_unit_map_active_ = true;
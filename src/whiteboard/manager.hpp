@@ -36,6 +36,7 @@ namespace wb {
 
 class mapbuilder;
 class highlighter;
+struct validity_cache;
 
 /**
  * This class is the frontend of the whiteboard framework for the rest of the Wesnoth code.
@@ -225,6 +226,8 @@ private:
 
 
 	std::unique_ptr<mapbuilder> mapbuilder_;
+	/** Validation results shared between map builds. */
+	std::unique_ptr<validity_cache> validity_cache_;
 	std::shared_ptr<highlighter> highlighter_;
 
 	std::unique_ptr<pathfind::marked_route> route_;
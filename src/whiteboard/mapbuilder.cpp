@@ -34,8 +34,10 @@
 namespace wb
 {
 
-mapbuilder::mapbuilder(unit_map& unit_map)
+mapbuilder::mapbuilder(unit_map& unit_map, validity_cache* cache)
 	: unit_map_(unit_map)
+	, cache_(cache)
+	, cache_current_(false)
 	, applied_actions_()
 	, applied_actions_this_turn_()
 	, resetters_()
@@ -93,6 +95,21 @@ void mapbuilder::build_map()
 		return;
 	}
 
+	if(cache_) {
+		validity_cache::key_type key;
+		key.gamestate_revision = cache_->gamestate_revision;
+		key.viewer_team = viewer_team();
+		for(team& side : resources::gameboard->teams()) {
+			key.plan_revisions.push_back(team_has_visible_plan(side) ? side.get_side_actions()->revision() : 0);
+		}
+
+		cache_current_ = key == cache_->key;
+		if(!cache_current_) {
+			cache_->key = std::move(key);
+			cache_->results.clear();
+		}
+	}
+
 	bool stop = false;
 	for(std::size_t turn=0; !stop; ++turn) {
 		stop = true;
@@ -130,7 +147,7 @@ void mapbuilder::process(side_actions &sa, side_actions::iterator action_it, boo
 	}
 
 	// Validity check
-	action::error erval = action->check_validity();
+	action::error erval = check_validity(*action);
 	action->redraw();
 
 	if(erval != action::OK) {
@@ -197,6 +214,24 @@ void mapbuilder::post_visit_team(std::size_t turn)
 	acted_this_turn_.clear();
 }
 
+action::error mapbuilder::check_validity(const action& act)
+{
+	if(!cache_) {
+		return act.check_validity();
+	}
+
+	if(cache_current_) {
+		auto it = cache_->results.find(&act);
+		if(it != cache_->results.end()) {
+			return it->second;
+		}
+	}
+
+	const action::error res = act.check_validity();
+	cache_->results[&act] = res;
+	return res;
+}
+
 void mapbuilder::restore_normal_map()
 {
 	//applied_actions_ contain only the actions that we applied to the unit map
@@ -22,6 +22,7 @@
 #include "side_actions.hpp"
 
 #include <list>
+#include <map>
 
 
 struct unit_movement_resetter;
@@ -31,6 +32,41 @@ struct temporary_unit_remover;
 namespace wb
 {
 
+/**
+ * Results of the last full validation of every planned action.
+ *
+ * Validating a move means pathfinding and validating an attack means building
+ * a battle context, but the result can only change when the game state, a
+ * plan or the viewing team changes. The whiteboard manager keeps one of these
+ * between map builds so that the many builds in between (mouseover, menus,
+ * redraws) only apply the actions instead of validating them again.
+ */
+struct validity_cache
+{
+	/** Identifies everything the cached results depend on. */
+	struct key_type
+	{
+		/** Incremented by manager::on_gamestate_change() and forced validations. */
+		std::size_t gamestate_revision = 0;
+		std::size_t viewer_team = 0;
+		/** side_actions::revision() of every team, or 0 for hidden plans. */
+		std::vector<std::size_t> plan_revisions;
+
+		bool operator==(const key_type& o) const
+		{
+			return gamestate_revision == o.gamestate_revision && viewer_team == o.viewer_team
+				&& plan_revisions == o.plan_revisions;
+		}
+	};
+
+	/** What the results were computed from. */
+	key_type key;
+	std::map<const action*, action::error> results;
+
+	/** Current game state revision, maintained by the manager. */
+	std::size_t gamestate_revision = 0;
+};
+
 /**
  * Class that collects and applies unit_map modifications from the actions it visits
  * and reverts all changes on destruction.
@@ -39,7 +75,10 @@ class mapbuilder
 {
 
 public:
-	mapbuilder(unit_map& unit_map);
+	/**
+	 * @param cache              If not null, validation results are taken from and stored to it.
+	 */
+	mapbuilder(unit_map& unit_map, validity_cache* cache = nullptr);
 	virtual ~mapbuilder();
 
 	/**
@@ -59,8 +98,15 @@ private:
 
 	void restore_normal_map();
 
+	/** Validates the action, or looks up its validity in cache_ when nothing changed. */
+	action::error check_validity(const action& act);
+
 	unit_map& unit_map_;
 
+	validity_cache* cache_;
+	/** Whether the results in cache_ are still up to date. */
+	bool cache_current_;
+
 	action_queue applied_actions_;
 	action_queue applied_actions_this_turn_;
 
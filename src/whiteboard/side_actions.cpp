@@ -71,7 +71,15 @@ std::ostream &operator<<(std::ostream &out, const wb::side_actions& side_actions
 side_actions_container::side_actions_container()
 	: actions_()
 	, turn_beginnings_()
+	, revision_(0)
 {
+	touch();
+}
+
+void side_actions_container::touch()
+{
+	static std::size_t last_revision = 0;
+	revision_ = ++last_revision;
 }
 
 std::size_t side_actions_container::get_turn_impl(std::size_t begin, std::size_t end, const_iterator it) const
@@ -147,6 +155,7 @@ side_actions_container::iterator side_actions_container::insert(iterator positio
 	if(!res.second) {
 		return end();
 	}
+	touch();
 	if(first) {
 		// If we are inserting before the first action, then the inserted action should became the first of turn 0.
 		turn_beginnings_.front() = begin();
@@ -169,6 +178,7 @@ side_actions_container::iterator side_actions_container::queue(std::size_t turn_
 	if(!res.second) {
 		return end();
 	}
+	touch();
 
 	if(future_only) {
 		// No action are planned for the current turn but we are planning an action for turn 1 (the next turn).
@@ -194,6 +204,7 @@ side_actions_container::iterator side_actions_container::bump_earlier(iterator p
 
 	actions_.replace(position, lhs);
 	actions_.replace(position - 1, rhs);
+	touch();
 	return position - 1;
 }
 
@@ -243,6 +254,7 @@ side_actions_container::iterator side_actions_container::erase(iterator position
 	}
 
 	//erase!
+	touch();
 	return actions_.erase(position);
 }
 
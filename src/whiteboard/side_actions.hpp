@@ -137,7 +137,7 @@ public:
 	/**
 	 * Empties the action queue.
 	 */
-	void clear() { actions_.clear(); turn_beginnings_.clear(); }
+	void clear() { actions_.clear(); turn_beginnings_.clear(); touch(); }
 
 	/**
 	 * Shift turn.
@@ -145,12 +145,12 @@ public:
 	 * The turn 0 is deleted, the actions of turn n are moved to turn n-1.
 	 * @pre turn_size(0)==0
 	 */
-	void turn_shift() { assert(turn_size(0)==0); turn_beginnings_.pop_front(); }
+	void turn_shift() { assert(turn_size(0)==0); turn_beginnings_.pop_front(); touch(); }
 
 	/**
 	 * Replaces the action at a given position with another action.
 	 */
-	bool replace(iterator it, action_ptr act){ return actions_.replace(it, act); }
+	bool replace(iterator it, action_ptr act){ touch(); return actions_.replace(it, act); }
 
 
 	/**
@@ -255,8 +255,19 @@ public:
 	const action_set& actions() const { return actions_; }
 
 	template<typename Modifier>
-	bool modify(iterator position, Modifier mod) { return actions_.modify(position, mod); }
+	bool modify(iterator position, Modifier mod) { touch(); return actions_.modify(position, mod); }
+
+	/**
+	 * Identifies the current contents of the queue.
+	 *
+	 * Every change to the queue gives it a new revision, which is never
+	 * reused by this or any other container.
+	 */
+	std::size_t revision() const { return revision_; }
 private:
+	/** Marks the queue as changed. */
+	void touch();
+
 	/**
 	 * Binary search to find the occurring turn of the action pointed by an iterator.
 	 */
@@ -270,6 +281,8 @@ private:
 	 * @invariant turn_beginnings_.front()==actions_.begin() || actions_.empty()
 	 */
 	action_limits turn_beginnings_;
+
+	std::size_t revision_;
 };
 
 
@@ -339,6 +352,9 @@ public:
 	 */
 	std::size_t num_turns() const { return actions_.num_turns(); }
 
+	/** Identifies the current contents of the queue, see side_actions_container::revision(). */
+	std::size_t revision() const { return actions_.revision(); }
+
 	/** Returns the number of actions planned for turn turn_num */
 	std::size_t turn_size(std::size_t turn_num) const { return actions_.turn_size(turn_num); }
 